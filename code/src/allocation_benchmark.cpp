@@ -0,0 +1,117 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "convert.h"
+#include "example_graphs.h"
+#include "rcsp.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+
+// Count heap allocations by replacing the global allocation functions. The array and nothrow forms call these. This is
+// a separate executable from benchmark.cpp so that the counting does not add an atomic increment to the allocations of
+// the timed benchmarks.
+static std::atomic<size_t> heap_allocation_count = 0;
+
+void *operator new(size_t bytes) {
+  ++heap_allocation_count;
+  if (void *p = std::malloc(bytes == 0 ? 1 : bytes)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment) {
+  ++heap_allocation_count;
+  const auto align = static_cast<size_t>(alignment);
+  if (void *p = std::aligned_alloc(align, (bytes + align - 1) / align * align)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+void static generate(long n_sites, long random_seed, perf_rcsp::SourceTargetBoostGraph &s_t_g) {
+  perf_rcsp::generate(static_cast<int>(n_sites), static_cast<int>(random_seed), s_t_g);
+}
+
+constexpr perf_rcsp::State initial_state{};
+
+// How ping_pong_rcsp_allocations solves: without a workspace, with one, or with one and a visitor that takes the first
+// 10 paths in cost order.
+enum class SolveMode { cold, workspace, visit };
+
+// Solve the same instance repeatedly, as in a column generation loop, and report the heap allocations per solve
+// with and without a reused workspace.
+template <SolveMode Mode> static void ping_pong_rcsp_allocations(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  const perf_rcsp::CsrGraph csr_graph(graph);
+  perf_rcsp::PingPongWorkspace workspace;
+  size_t path_edge_count = 0;
+  auto take_first_paths = [&path_edge_count, visit_count = 0](auto path, const auto &) mutable {
+    path_edge_count += path.size();
+    return ++visit_count < 10;
+  };
+  auto solve = [&] {
+    if constexpr (Mode == SolveMode::cold) {
+      auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state);
+      benchmark::DoNotOptimize(solutions.nondominated_end_states.data());
+    } else if constexpr (Mode == SolveMode::workspace) {
+      const auto &solutions =
+        find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace);
+      benchmark::DoNotOptimize(solutions.nondominated_end_states.data());
+    } else {
+      visit_ping_pong_solutions(
+        csr_graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace, auto(take_first_paths)
+      );
+      benchmark::DoNotOptimize(path_edge_count);
+    }
+  };
+  if constexpr (Mode != SolveMode::cold) {
+    // The warm-up solves size the workspace's buffers.
+    for (int i = 0; i < 2; ++i) {
+      solve();
+    }
+  }
+
+  const size_t allocation_count_before = heap_allocation_count;
+  for (auto _ : state) {
+    solve();
+  }
+  state.counters["heap_allocations_per_solve"] = benchmark::Counter(
+    static_cast<double>(heap_allocation_count - allocation_count_before), benchmark::Counter::kAvgIterations
+  );
+}
+
+BENCHMARK(ping_pong_rcsp_allocations<SolveMode::cold>)
+  ->Name("ping_pong_rcsp_allocations/cold")
+  ->Unit(benchmark::kMillisecond)
+  ->ArgsProduct({{100}, {8, 12}});
+BENCHMARK(ping_pong_rcsp_allocations<SolveMode::workspace>)
+  ->Name("ping_pong_rcsp_allocations/workspace")
+  ->Unit(benchmark::kMillisecond)
+  ->ArgsProduct({{100}, {8, 12}});
+BENCHMARK(ping_pong_rcsp_allocations<SolveMode::visit>)
+  ->Name("ping_pong_rcsp_allocations/visit_first_10")
+  ->Unit(benchmark::kMillisecond)
+  ->ArgsProduct({{100}, {8, 12}});
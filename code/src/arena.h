@@ -0,0 +1,90 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace perf_rcsp {
+
+// Arena is a bump allocator: allocations are carved out of one buffer, deallocation is a no-op and reset makes the
+// whole buffer available again. Allocations that do not fit in the buffer are taken from the heap until the next
+// reset, which then grows the buffer so that a repeated workload of the same size is served without heap allocations.
+class Arena final : public std::pmr::memory_resource {
+  struct OverflowBlock {
+    void *p;
+    size_t bytes;
+    size_t alignment;
+  };
+
+  std::unique_ptr<std::byte[]> buffer;
+  size_t capacity = 0;
+  size_t used = 0;
+  size_t overflow_bytes = 0;
+  std::vector<OverflowBlock> overflow_blocks;
+
+public:
+  Arena() = default;
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena() override { release_overflow_blocks(); }
+
+  // Invalidates all memory allocated from the arena.
+  void reset() {
+    release_overflow_blocks();
+    if (overflow_bytes > 0) {
+      capacity += overflow_bytes;
+      buffer = std::make_unique_for_overwrite<std::byte[]>(capacity);
+    }
+    used = 0;
+    overflow_bytes = 0;
+  }
+
+  [[nodiscard]] size_t get_capacity() const { return capacity; }
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    const size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (offset + bytes <= capacity) {
+      used = offset + bytes;
+      return buffer.get() + offset;
+    }
+    // Account for the worst case alignment padding when the buffer grows.
+    overflow_bytes += bytes + alignment;
+    void *p = ::operator new(bytes, std::align_val_t{alignment});
+    overflow_blocks.push_back({p, bytes, alignment});
+    return p;
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+
+  void release_overflow_blocks() {
+    for (const auto &block : overflow_blocks) {
+      ::operator delete(block.p, block.bytes, std::align_val_t{block.alignment});
+    }
+    overflow_blocks.clear();
+  }
+};
+
+} // namespace perf_rcsp
+
+#endif // ARENA_H
@@ -13,10 +13,18 @@
 // <https://www.gnu.org/licenses/>.
 //
 
+#include "bidirectional.h"
 #include "convert.h"
 #include "example_graphs.h"
+#include "graph_file.h"
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <bitset>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <vector>
 
 void static generate(long n_sites, long random_seed, perf_rcsp::SourceTargetBoostGraph &s_t_g) {
   perf_rcsp::generate(static_cast<int>(n_sites), static_cast<int>(random_seed), s_t_g);
@@ -25,34 +33,472 @@ void static generate(long n_sites, long random_seed, perf_rcsp::SourceTargetBoos
 constexpr perf_rcsp::State initial_state{};
 
 static void boost_rcsp(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
   for (auto _ : state) {
-    state.PauseTiming();
-    perf_rcsp::SourceTargetBoostGraph s_t_g;
-    generate(state.range(1), state.range(0), s_t_g);
-    state.ResumeTiming();
     auto solutions = find_boost_solutions(s_t_g, initial_state);
     // It is intended that the generated instance should have some solutions.
     ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
   }
 }
 
+static void bidirectional_rcsp(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_bidirectional_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state);
+    // It is intended that the generated instance should have some solutions.
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+static void ping_pong_rcsp_completion_bounds(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, {.prune_with_completion_bounds = true}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+static void ping_pong_rcsp_time_queue(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state,
+      {.schedule = perf_rcsp::PingPongSchedule::time_queue}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+static void ping_pong_rcsp_lazy_dominance(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, {.lazy_dominance = true}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+static void ping_pong_rcsp_label_tree_compaction(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, {.label_tree_compaction_size = 1 << 16}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+static void ping_pong_rcsp_time_buckets(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, {.time_bucket_width = 5}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
+// The heuristic pricing of the early column generation iterations.
+static void ping_pong_rcsp_heuristic(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state,
+      {.max_labels_per_vertex = 16, .max_out_edges_per_vertex = 6, .max_solutions = 10}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+}
+
 static void ping_pong_rcsp(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
   for (auto _ : state) {
-    state.PauseTiming();
-    perf_rcsp::SourceTargetBoostGraph s_t_g;
-    generate(state.range(1), state.range(0), s_t_g);
-    auto graph = convert_to_graph(s_t_g.graph);
-    state.ResumeTiming();
     auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state);
     // It is intended that the generated instance should have some solutions.
     ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
   }
 }
 
+namespace legacy {
+// State, is_dominate and extend as they were before the delivered set was stored as an integer mask. Kept to
+// compare against in isolation.
+struct State {
+  int cost = 0;
+  int time = 0;
+  int energy = 0;
+  std::bitset<perf_rcsp::N_DELIVERIES> delivered;
+};
+
+bool is_dominate(const State &lhs, const State &rhs) {
+  if (lhs.cost > rhs.cost) {
+    return false;
+  }
+  if (lhs.time > rhs.time) {
+    return false;
+  }
+  if (lhs.energy < rhs.energy) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.delivered.size(); ++i) {
+    if (rhs.delivered.test(i) && !lhs.delivered.test(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool extend(const State &old_state, const perf_rcsp::ExtensionData &extension_data, State &new_state) {
+  if (extension_data.latest_time < old_state.time) {
+    return false;
+  }
+  if (old_state.energy < -extension_data.energy_change) {
+    return false;
+  }
+  const bool is_delivery = extension_data.delivery_index < perf_rcsp::NOT_A_DELIVERY_MARKER;
+  if (is_delivery && old_state.delivered.test(extension_data.delivery_index)) {
+    return false;
+  }
+  new_state = old_state;
+  new_state.cost += extension_data.cost_change;
+  new_state.time += extension_data.time_change;
+  new_state.energy += extension_data.energy_change;
+  if (is_delivery) {
+    new_state.delivered.set(extension_data.delivery_index);
+  }
+  return true;
+}
+} // namespace legacy
+
+// Random states with the same values for both the legacy and the current State. The small ranges make
+// dominance checks that reach the delivered comparison common.
+template <typename StateType> std::vector<StateType> random_states(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<> resource_distribution(0, 3);
+  std::uniform_int_distribution<> delivery_distribution(0, perf_rcsp::N_DELIVERIES - 1);
+  std::vector<StateType> states(count);
+  for (auto &s : states) {
+    s.cost = resource_distribution(gen);
+    s.time = resource_distribution(gen);
+    s.energy = resource_distribution(gen);
+    for (int i = 0; i < 4; ++i) {
+      s.delivered.set(delivery_distribution(gen));
+    }
+  }
+  return states;
+}
+
+std::vector<perf_rcsp::ExtensionData> random_extension_data(size_t count) {
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<> delivery_distribution(0, perf_rcsp::N_DELIVERIES);
+  std::vector<perf_rcsp::ExtensionData> extensions(count);
+  for (auto &e : extensions) {
+    e = perf_rcsp::ExtensionData{0, 0, 100, 2, 1, 0, delivery_distribution(gen)};
+  }
+  return extensions;
+}
+
+constexpr size_t state_count = 1024;
+
+// is_dominate and extend are found by argument-dependent lookup for both StateType's.
+template <typename StateType> static void is_dominate_all_pairs(benchmark::State &state) {
+  const auto states = random_states<StateType>(state_count);
+  for (auto _ : state) {
+    size_t dominated_count = 0;
+    for (const auto &lhs : states) {
+      for (const auto &rhs : states) {
+        dominated_count += is_dominate(lhs, rhs);
+      }
+    }
+    benchmark::DoNotOptimize(dominated_count);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state_count * state_count));
+}
+
+template <typename StateType> static void extend_all(benchmark::State &state) {
+  const auto states = random_states<StateType>(state_count);
+  const auto extensions = random_extension_data(state_count);
+  for (auto _ : state) {
+    size_t extended_count = 0;
+    StateType new_state;
+    for (const auto &old_state : states) {
+      for (const auto &extension_data : extensions) {
+        extended_count += extend(old_state, extension_data, new_state);
+      }
+    }
+    benchmark::DoNotOptimize(extended_count);
+    benchmark::DoNotOptimize(new_state);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state_count * state_count));
+}
+
+BENCHMARK(is_dominate_all_pairs<legacy::State>)->Name("is_dominate/bitset_loop");
+BENCHMARK(is_dominate_all_pairs<perf_rcsp::State>)->Name("is_dominate/mask");
+BENCHMARK(extend_all<legacy::State>)->Name("extend/bitset_loop");
+BENCHMARK(extend_all<perf_rcsp::State>)->Name("extend/mask");
+
+// Price a sequence of 10 perturbed cost vectors, as in the iterations of a column generation loop, with a search per
+// cost vector or with one search followed by repricing its label tree.
+template <bool Reprice> static void ping_pong_rcsp_repricing(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  auto graph = convert_to_graph(s_t_g.graph);
+  std::vector<int> base_cost_changes;
+  for (perf_rcsp::Index edge_index = 0; edge_index < graph.edge_count(); ++edge_index) {
+    base_cost_changes.push_back(graph.get_extension_data(edge_index).cost_change);
+  }
+  std::mt19937 rng(state.range(0));
+  std::uniform_int_distribution<int> dual_distribution(0, 10);
+  std::vector<std::vector<int>> duals(10, std::vector<int>(perf_rcsp::N_DELIVERIES));
+  for (auto &iteration_duals : duals) {
+    std::ranges::generate(iteration_duals, [&] { return dual_distribution(rng); });
+  }
+  perf_rcsp::PingPongWorkspace workspace;
+  perf_rcsp::CsrGraph csr_graph;
+
+  for (auto _ : state) {
+    for (size_t iteration = 0; iteration < duals.size(); ++iteration) {
+      graph.apply_duals(base_cost_changes, duals[iteration]);
+      csr_graph.assign(graph);
+      if (Reprice && iteration > 0) {
+        const auto &solutions = reprice_ping_pong_solutions(csr_graph, workspace);
+        benchmark::DoNotOptimize(solutions.nondominated_end_states.data());
+      } else {
+        const auto &solutions =
+          find_ping_pong_solutions(csr_graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace);
+        benchmark::DoNotOptimize(solutions.nondominated_end_states.data());
+      }
+    }
+  }
+}
+
+BENCHMARK(ping_pong_rcsp_repricing<false>)
+  ->Name("ping_pong_rcsp_repricing/cold")
+  ->Unit(benchmark::kMillisecond)
+  ->ArgsProduct({{100, 101}, {10, 13}});
+BENCHMARK(ping_pong_rcsp_repricing<true>)
+  ->Name("ping_pong_rcsp_repricing/reprice")
+  ->Unit(benchmark::kMillisecond)
+  ->ArgsProduct({{100, 101}, {10, 13}});
+
+// Get the CSR graph of an instance by generating and converting it, or by mapping a graph file written beforehand.
+template <bool Mapped> static void load_instance(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  perf_rcsp::generate(static_cast<int>(state.range(0)), 100, s_t_g);
+  const auto path = std::filesystem::temp_directory_path() / "perf_rcsp_benchmark.graph";
+  write_graph_file(path, convert_to_graph(s_t_g.graph), s_t_g.source_vertex, s_t_g.target_vertex);
+  for (auto _ : state) {
+    if (Mapped) {
+      const perf_rcsp::GraphFile file(path);
+      benchmark::DoNotOptimize(file.csr_graph().out_edge_data(file.target_vertex_index()).data());
+    } else {
+      perf_rcsp::SourceTargetBoostGraph generated;
+      perf_rcsp::generate(static_cast<int>(state.range(0)), 100, generated);
+      const perf_rcsp::CsrGraph csr_graph(convert_to_graph(generated.graph));
+      benchmark::DoNotOptimize(csr_graph.out_edge_data(generated.target_vertex).data());
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(load_instance<false>)->Name("load_instance/generate")->Arg(15)->Arg(31);
+BENCHMARK(load_instance<true>)->Name("load_instance/mapped_file")->Arg(15)->Arg(31);
+
+// Generate an instance with range(0) sites as a Graph, via the BoostGraph and its conversion or directly.
+template <bool Direct> static void generate_instance(benchmark::State &state) {
+  constexpr int capacity = 256;
+  const int sites_count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    if constexpr (Direct) {
+      const auto graph = perf_rcsp::generate_graph<capacity>(perf_rcsp::InstanceFamily::uniform, sites_count, 100);
+      benchmark::DoNotOptimize(graph.get_vertices().data());
+    } else {
+      perf_rcsp::BasicSourceTargetBoostGraph<capacity> generated;
+      perf_rcsp::generate(sites_count, 100, generated);
+      const auto graph = convert_to_graph(generated.graph);
+      benchmark::DoNotOptimize(graph.get_vertices().data());
+    }
+  }
+}
+
+BENCHMARK(generate_instance<false>)->Name("generate_instance/boost")->Arg(31)->Arg(127)->Arg(255);
+BENCHMARK(generate_instance<true>)->Name("generate_instance/direct")->Arg(31)->Arg(127)->Arg(255);
+
+// Solve with the rounds split over a thread pool of range(2) threads.
+static void ping_pong_rcsp_parallel(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  perf_rcsp::ThreadPool pool(state.range(2));
+  perf_rcsp::PingPongWorkspace workspace;
+  for (auto _ : state) {
+    const auto &solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace, {.thread_pool = &pool}
+    );
+    benchmark::DoNotOptimize(solutions.nondominated_end_states.data());
+  }
+}
+
+BENCHMARK(ping_pong_rcsp_parallel)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime()
+  ->ArgsProduct({{100, 101}, {13, 14}, {1, 2, 4, 8}});
+
+// Price 16 queries on the same graph, e.g. one per vehicle type, in one batch on a pool of range(2) threads.
+static void ping_pong_rcsp_batch(benchmark::State &state) {
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  generate(state.range(1), state.range(0), s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  std::vector<perf_rcsp::PingPongQuery> queries;
+  for (int i = 0; i < 16; ++i) {
+    queries.push_back({s_t_g.source_vertex, s_t_g.target_vertex, perf_rcsp::State{.time = i, .energy = i % 4}});
+  }
+  perf_rcsp::ThreadPool pool(state.range(2));
+  std::vector<perf_rcsp::PingPongWorkspace> workspaces(pool.size());
+  for (auto _ : state) {
+    auto solutions = find_ping_pong_solutions(graph, queries, pool, workspaces);
+    benchmark::DoNotOptimize(solutions.data());
+  }
+}
+
+BENCHMARK(ping_pong_rcsp_batch)->Unit(benchmark::kMillisecond)->UseRealTime()->ArgsProduct({{100}, {10}, {1, 2, 4, 8}});
+
+// The scaling suite solves larger instances of each perf_rcsp::InstanceFamily. The fixture generates the instance once
+// per benchmark run, outside the timed loop, and the search counters of the last solve are reported, so that changes
+// in the run times can be explained by changes in the search. The arguments are the family, the seed and the number
+// of sites.
+class InstanceFixture : public benchmark::Fixture {
+public:
+  void SetUp(benchmark::State &state) override {
+    perf_rcsp::generate(
+      static_cast<perf_rcsp::InstanceFamily>(state.range(0)), static_cast<int>(state.range(2)),
+      static_cast<int>(state.range(1)), s_t_g
+    );
+    graph = perf_rcsp::CsrGraph(convert_to_graph(s_t_g.graph));
+  }
+
+  void report_counters(benchmark::State &state, const perf_rcsp::PingPongWorkspace &workspace) const {
+    const auto &counters = workspace.counters();
+    state.counters["labels_created"] = static_cast<double>(counters.labels_created);
+    state.counters["labels_dominated"] = static_cast<double>(counters.labels_dominated);
+    state.counters["label_tree_size"] = static_cast<double>(counters.peak_label_tree_size);
+    state.counters["rounds"] = static_cast<double>(counters.rounds);
+    if constexpr (perf_rcsp::search_stats) {
+      const auto &stats = workspace.stats();
+      state.counters["extensions_attempted"] = static_cast<double>(stats.extensions.attempted);
+      state.counters["dominance_checks"] = static_cast<double>(stats.extensions.dominance_checks);
+      state.counters["peak_labels_per_vertex"] = static_cast<double>(stats.peak_labels_per_vertex);
+      const auto phase_share = [&stats](std::chrono::nanoseconds phase_time) {
+        const auto total_time = stats.compaction_time + stats.vertex_ordering_time + stats.extension_time;
+        return static_cast<double>(phase_time.count()) / static_cast<double>(total_time.count());
+      };
+      state.counters["compaction_share"] = phase_share(stats.compaction_time);
+      state.counters["extension_share"] = phase_share(stats.extension_time);
+    }
+  }
+
+  perf_rcsp::SourceTargetBoostGraph s_t_g;
+  perf_rcsp::CsrGraph graph;
+};
+
+BENCHMARK_DEFINE_F(InstanceFixture, ping_pong_rcsp)(benchmark::State &state) {
+  perf_rcsp::PingPongWorkspace workspace;
+  for (auto _ : state) {
+    const auto &solutions =
+      find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace);
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+  report_counters(state, workspace);
+}
+
+BENCHMARK_DEFINE_F(InstanceFixture, ping_pong_rcsp_time_queue)(benchmark::State &state) {
+  perf_rcsp::PingPongWorkspace workspace;
+  for (auto _ : state) {
+    const auto &solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace,
+      {.schedule = perf_rcsp::PingPongSchedule::time_queue}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+  report_counters(state, workspace);
+}
+
+// The fourth argument is the VertexOrder, so that the labels created and dominated can be compared across the orders.
+BENCHMARK_DEFINE_F(InstanceFixture, ping_pong_rcsp_vertex_order)(benchmark::State &state) {
+  perf_rcsp::PingPongWorkspace workspace;
+  const auto order = static_cast<perf_rcsp::VertexOrder>(state.range(3));
+  for (auto _ : state) {
+    const auto &solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, initial_state, workspace, {.vertex_order = order}
+    );
+    ASSERT_ALWAYS(!solutions.nondominated_end_states.empty());
+  }
+  report_counters(state, workspace);
+}
+
+// The uniform and scarce charger instances with 31 sites take over a minute, so they stop at 23 sites.
+const std::vector<int64_t> dense_instance_families = {
+  static_cast<int64_t>(perf_rcsp::InstanceFamily::uniform),
+  static_cast<int64_t>(perf_rcsp::InstanceFamily::scarce_chargers)
+};
+const std::vector<int64_t> sparse_instance_families = {
+  static_cast<int64_t>(perf_rcsp::InstanceFamily::clustered),
+  static_cast<int64_t>(perf_rcsp::InstanceFamily::tight_windows)
+};
+const auto scaling_seeds = benchmark::CreateDenseRange(100, 104, 1);
+
+BENCHMARK_REGISTER_F(InstanceFixture, ping_pong_rcsp)
+  ->Unit(benchmark::kMillisecond)
+  ->ArgNames({"family", "seed", "sites"})
+  ->ArgsProduct({dense_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 23, 4)})
+  ->ArgsProduct({sparse_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 31, 4)});
+BENCHMARK_REGISTER_F(InstanceFixture, ping_pong_rcsp_time_queue)
+  ->Unit(benchmark::kMillisecond)
+  ->ArgNames({"family", "seed", "sites"})
+  ->ArgsProduct({dense_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 23, 4)})
+  ->ArgsProduct({sparse_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 31, 4)});
+
+const std::vector<int64_t> vertex_orders = {
+  static_cast<int64_t>(perf_rcsp::VertexOrder::min_time), static_cast<int64_t>(perf_rcsp::VertexOrder::min_cost),
+  static_cast<int64_t>(perf_rcsp::VertexOrder::min_average_cost_change),
+  static_cast<int64_t>(perf_rcsp::VertexOrder::topological_by_time)
+};
+BENCHMARK_REGISTER_F(InstanceFixture, ping_pong_rcsp_vertex_order)
+  ->Unit(benchmark::kMillisecond)
+  ->ArgNames({"family", "seed", "sites", "order"})
+  ->ArgsProduct({dense_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 23, 4), vertex_orders})
+  ->ArgsProduct({sparse_instance_families, scaling_seeds, benchmark::CreateDenseRange(15, 31, 4), vertex_orders});
+
 const auto seeds = benchmark::CreateDenseRange(100, 114, 1);
 const auto site_counts = benchmark::CreateDenseRange(1, 15, 1);
 
 BENCHMARK(boost_rcsp)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
 BENCHMARK(ping_pong_rcsp)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(bidirectional_rcsp)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_completion_bounds)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_time_queue)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_lazy_dominance)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_label_tree_compaction)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_time_buckets)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
+BENCHMARK(ping_pong_rcsp_heuristic)->Unit(benchmark::kMillisecond)->ArgsProduct({seeds, site_counts});
 
 BENCHMARK_MAIN();
@@ -0,0 +1,258 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "bidirectional.h"
+
+#include "label_bucket.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace perf_rcsp {
+
+namespace {
+
+template <int Capacity> struct BackwardLabel {
+  BasicBackwardState<Capacity> state;
+  size_t label_tree_index = ROOT_MARKER;
+  bool dominated = false;
+};
+
+// Returns true if a label in labels dominates candidate. Otherwise, marks the labels that candidate dominates as
+// dominated and returns false. The backward labels need equal delivered sets to dominate, so there are few
+// comparable labels per vertex and a scalar loop suffices.
+template <int Capacity>
+bool is_dominated_or_mark_dominated(
+  std::vector<BackwardLabel<Capacity>> &labels,
+  const BasicBackwardState<Capacity> &candidate
+) {
+  for (const auto &label : labels) {
+    if (!label.dominated && is_dominate(label.state, candidate)) {
+      return true;
+    }
+  }
+  for (auto &label : labels) {
+    label.dominated = label.dominated || is_dominate(candidate, label.state);
+  }
+  return false;
+}
+
+// A min-priority queue of labels by a resource that is monotone along the search direction, with ties broken by
+// insertion order. Extending the labels in this order means that a label is usually only extended once all labels that
+// could dominate it exist, so few dominated labels are extended.
+class LabelQueue {
+  struct Entry {
+    int key;
+    size_t sequence;
+    Index vertex_index;
+    size_t label_index;
+    auto operator<=>(const Entry &) const = default;
+  };
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> entries;
+  size_t sequence = 0;
+
+public:
+  [[nodiscard]] bool empty() const { return entries.empty(); }
+  void push(int key, Index vertex_index, size_t label_index) {
+    entries.push(Entry{key, sequence++, vertex_index, label_index});
+  }
+  std::pair<Index, size_t> pop() {
+    const auto entry = entries.top();
+    entries.pop();
+    return {entry.vertex_index, entry.label_index};
+  }
+};
+
+template <int Capacity> int default_half_way_time(const BasicCsrGraph<Capacity> &g, int initial_time) {
+  int latest_arrival = initial_time;
+  for (Index v = 0; v < g.vertex_count(); ++v) {
+    for (const auto &data : g.out_edge_data(v)) {
+      ASSERT_ALWAYS(data.time_change >= 0);
+      latest_arrival = std::max(latest_arrival, std::max(data.latest_time, data.earliest_time) + data.time_change);
+    }
+  }
+  return initial_time + (latest_arrival - initial_time) / 2;
+}
+
+} // namespace
+
+template <int Capacity>
+BasicSolutions<Capacity> find_bidirectional_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const BidirectionalOptions &options
+) {
+  ASSERT_ALWAYS(source_index != target_index);
+  ASSERT_ALWAYS(g.out_edge_targets(target_index).empty());
+  const int half_way_time =
+    std::max(options.half_way_time.value_or(default_half_way_time(g, initial_state.time)), initial_state.time);
+  const size_t vertex_count = g.vertex_count();
+
+  // The forward labels are extended in order of increasing time and the backward ones in order of decreasing latest
+  // start. Both searches keep all their labels since the join needs them, and only extend the labels that are not
+  // dominated when their turn comes.
+  LabelQueue queue;
+
+  std::vector<BasicLabelBucket<Capacity>> forward_labels(vertex_count);
+  std::vector<LabelHistory> forward_label_tree;
+  forward_labels[source_index].push_back(initial_state, 0);
+  forward_label_tree.push_back(LabelHistory{ROOT_MARKER, 0, source_index, 0});
+  queue.push(initial_state.time, source_index, 0);
+  while (!queue.empty()) {
+    const auto [v, i] = queue.pop();
+    if (forward_labels[v].dominated(i) || forward_labels[v].time(i) > half_way_time) {
+      continue;
+    }
+    const auto state = forward_labels[v].state(i);
+    const size_t parent_label_tree_index = forward_labels[v].label_tree_index(i);
+    const auto targets = g.out_edge_targets(v);
+    const auto data = g.out_edge_data(v);
+    for (size_t out_edge_index = 0; out_edge_index != targets.size(); ++out_edge_index) {
+      BasicState<Capacity> new_state;
+      if (!extend(state, data[out_edge_index], new_state)) {
+        continue;
+      }
+      auto &labels = forward_labels[targets[out_edge_index]];
+      if (labels.is_dominated_or_mark_dominated(new_state)) {
+        continue;
+      }
+      const size_t label_tree_index = forward_label_tree.size();
+      forward_label_tree.emplace_back(parent_label_tree_index, label_tree_index, EdgeLocation{v, out_edge_index});
+      labels.push_back(new_state, label_tree_index);
+      queue.push(new_state.time, targets[out_edge_index], labels.size() - 1);
+    }
+  }
+
+  // The backward label tree links each suffix to the suffix after its first edge.
+  const InEdges in_edges(g);
+  std::vector<std::vector<BackwardLabel<Capacity>>> backward_labels(vertex_count);
+  std::vector<LabelHistory> backward_label_tree;
+  backward_labels[target_index].push_back(BackwardLabel<Capacity>{{}, 0});
+  backward_label_tree.push_back(LabelHistory{ROOT_MARKER, 0, target_index, 0});
+  queue.push(0, target_index, 0);
+  while (!queue.empty()) {
+    const auto [w, i] = queue.pop();
+    const auto label = backward_labels[w][i];
+    if (label.dominated || label.state.latest_start <= half_way_time) {
+      continue;
+    }
+    for (const auto &edge_location : in_edges.of(w)) {
+      const auto &data = g.out_edge_data(edge_location.source_vertex_index)[edge_location.out_edge_index];
+      BasicBackwardState<Capacity> new_state;
+      if (!extend_backward(label.state, data, initial_state.time, new_state)) {
+        continue;
+      }
+      auto &labels = backward_labels[edge_location.source_vertex_index];
+      if (is_dominated_or_mark_dominated(labels, new_state)) {
+        continue;
+      }
+      const size_t label_tree_index = backward_label_tree.size();
+      backward_label_tree.emplace_back(label.label_tree_index, label_tree_index, edge_location);
+      labels.push_back(BackwardLabel<Capacity>{new_state, label_tree_index});
+      queue.push(-new_state.latest_start, edge_location.source_vertex_index, labels.size() - 1);
+    }
+  }
+
+  // Each path splits into a prefix that ends at the last vertex that it reaches by half_way_time and a suffix that is
+  // started there, so joining the forward labels within half_way_time with the backward labels whose first edge
+  // arrives after half_way_time finds each path once. The other pairs are joined at a later vertex instead, where the
+  // forward search has extended the prefix along the first edge of the suffix.
+  // Dominated labels can be skipped since they are dominated by labels that make all the same joins or better ones.
+  BasicLabelBucket<Capacity> joined_labels;
+  std::vector<std::pair<size_t, size_t>> joined_label_tree_indices; // (forward, backward)
+  for (Index v = 0; v < vertex_count; ++v) {
+    const auto &labels = forward_labels[v];
+    for (size_t i = 0; i < labels.size(); ++i) {
+      if (labels.dominated(i) || labels.time(i) > half_way_time) {
+        continue;
+      }
+      const auto forward_state = labels.state(i);
+      for (const auto &backward_label : backward_labels[v]) {
+        if (backward_label.dominated) {
+          continue;
+        }
+        if (v != target_index) {
+          const auto &first_edge = backward_label_tree[backward_label.label_tree_index].edge_location;
+          const auto &first_edge_data = g.out_edge_data(v)[first_edge.out_edge_index];
+          const int first_edge_end =
+            std::max(forward_state.time, first_edge_data.earliest_time) + first_edge_data.time_change;
+          if (first_edge_end <= half_way_time) {
+            continue;
+          }
+        }
+        BasicState<Capacity> joined_state;
+        if (!join(forward_state, backward_label.state, joined_state)) {
+          continue;
+        }
+        if (joined_labels.is_dominated_or_mark_dominated(joined_state)) {
+          continue;
+        }
+        joined_labels.push_back(joined_state, joined_label_tree_indices.size());
+        joined_label_tree_indices.emplace_back(labels.label_tree_index(i), backward_label.label_tree_index);
+      }
+    }
+  }
+
+  BasicSolutions<Capacity> solutions;
+  for (size_t i = 0; i < joined_labels.size(); ++i) {
+    if (joined_labels.dominated(i)) {
+      continue;
+    }
+    auto [forward_label_tree_index, backward_label_tree_index] =
+      joined_label_tree_indices[joined_labels.label_tree_index(i)];
+    auto &path = solutions.nondominated_paths.emplace_back();
+    // The suffix is linked first edge first but the paths are stored last edge first.
+    while (backward_label_tree_index != ROOT_MARKER) {
+      const auto &lh = backward_label_tree[backward_label_tree_index];
+      path.push_back(lh.edge_location);
+      backward_label_tree_index = lh.parent_label_tree_index;
+    }
+    std::ranges::reverse(path);
+    while (forward_label_tree_index != ROOT_MARKER) {
+      const auto &lh = forward_label_tree[forward_label_tree_index];
+      path.push_back(lh.edge_location);
+      forward_label_tree_index = lh.parent_label_tree_index;
+    }
+    solutions.nondominated_end_states.push_back(joined_labels.state(i));
+  }
+  return solutions;
+}
+
+template <int Capacity>
+BasicSolutions<Capacity> find_bidirectional_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const BidirectionalOptions &options
+) {
+  return find_bidirectional_solutions(BasicCsrGraph<Capacity>(g), source_index, target_index, initial_state, options);
+}
+
+#define INSTANTIATE_FIND_BIDIRECTIONAL_SOLUTIONS(CAPACITY)                                                             \
+  template BasicSolutions<CAPACITY> find_bidirectional_solutions(                                                      \
+    const BasicCsrGraph<CAPACITY> &, Index, Index, BasicState<CAPACITY>, const BidirectionalOptions &                  \
+  );                                                                                                                   \
+  template BasicSolutions<CAPACITY> find_bidirectional_solutions(                                                      \
+    const BasicGraph<CAPACITY> &, Index, Index, BasicState<CAPACITY>, const BidirectionalOptions &                     \
+  );
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_FIND_BIDIRECTIONAL_SOLUTIONS)
+
+} // namespace perf_rcsp
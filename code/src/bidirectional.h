@@ -0,0 +1,144 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef BIDIRECTIONAL_H
+#define BIDIRECTIONAL_H
+
+#include "csr_graph.h"
+#include "graph.h"
+#include "rcsp.h"
+#include "vrp_model.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace perf_rcsp {
+
+// A backward label describes a path suffix, i.e. a path from some vertex to the target, independently of the time and
+// energy that it is started with. A forward State (time t, energy e) can be completed with the suffix if and only if
+// t <= latest_start and e >= energy_requirement, and no delivery is made twice. Because of the waiting at the edges'
+// earliest times, the suffix then ends at time max(t + duration, earliest_end).
+template <int Capacity> struct BasicBackwardState {
+  int cost = 0;
+  int duration = 0;
+  int latest_start = std::numeric_limits<int>::max();
+  int earliest_end = std::numeric_limits<int>::min();
+  int energy_requirement = 0;
+  int energy_change = 0;
+  BasicDeliverySet<Capacity> delivered;
+  bool operator==(const BasicBackwardState &) const = default;
+};
+using BackwardState = BasicBackwardState<N_DELIVERIES>;
+
+// Return true if and only if every forward State that can be completed with rhs can also be completed with lhs and
+// the result is as good as or better. Since a delivery in lhs but not in rhs could block the completion of some forward
+// State, and a delivery in rhs but not in lhs makes a better result, the delivered sets must be equal.
+template <int Capacity>
+bool is_dominate(const BasicBackwardState<Capacity> &lhs, const BasicBackwardState<Capacity> &rhs) {
+  return lhs.cost <= rhs.cost && lhs.duration <= rhs.duration && lhs.latest_start >= rhs.latest_start &&
+         lhs.earliest_end <= rhs.earliest_end && lhs.energy_requirement <= rhs.energy_requirement &&
+         lhs.energy_change >= rhs.energy_change && lhs.delivered == rhs.delivered;
+}
+
+// Prepend the edge of extension_data to the suffix of old_state, i.e. the backward counterpart of extend.
+// Returns false if the new suffix can not be started at earliest_start or later or would make a delivery twice.
+template <int Capacity, typename ExtensionDataType>
+bool extend_backward(
+  const BasicBackwardState<Capacity> &old_state,
+  const ExtensionDataType &extension_data,
+  int earliest_start,
+  BasicBackwardState<Capacity> &new_state
+) {
+  const bool is_delivery = extension_data.delivery_index < not_a_delivery_marker<Capacity>;
+  if (is_delivery && old_state.delivered.test(extension_data.delivery_index)) {
+    return false;
+  }
+
+  // The edge ends at max(t, earliest_time) + time_change, which must be at most the old latest start.
+  const int latest_departure = old_state.latest_start - extension_data.time_change;
+  const int latest_start = std::min(extension_data.latest_time, latest_departure);
+  if (latest_start < earliest_start || extension_data.earliest_time > latest_departure) {
+    return false;
+  }
+
+  new_state = old_state;
+  new_state.cost += extension_data.cost_change;
+  new_state.duration += extension_data.time_change;
+  new_state.latest_start = latest_start;
+  new_state.earliest_end =
+    std::max(old_state.earliest_end, extension_data.earliest_time + extension_data.time_change + old_state.duration);
+  // the energy before the edge must cover both the edge and the rest of the suffix
+  new_state.energy_requirement =
+    std::max(-extension_data.energy_change, old_state.energy_requirement - extension_data.energy_change);
+  new_state.energy_change += extension_data.energy_change;
+  if (is_delivery) {
+    new_state.delivered.set(extension_data.delivery_index);
+  }
+  return true;
+}
+
+// Returns true if forward_state can be completed with the suffix of backward_state and then sets joined_state to the
+// state at the end of the suffix.
+template <int Capacity>
+bool join(
+  const BasicState<Capacity> &forward_state,
+  const BasicBackwardState<Capacity> &backward_state,
+  BasicState<Capacity> &joined_state
+) {
+  if (forward_state.time > backward_state.latest_start || forward_state.energy < backward_state.energy_requirement ||
+      !forward_state.delivered.is_disjoint_from(backward_state.delivered)) {
+    return false;
+  }
+  joined_state = forward_state;
+  joined_state.cost += backward_state.cost;
+  joined_state.time = std::max(forward_state.time + backward_state.duration, backward_state.earliest_end);
+  joined_state.energy += backward_state.energy_change;
+  joined_state.delivered |= backward_state.delivered;
+  return true;
+}
+
+struct BidirectionalOptions {
+  // Forward labels are extended while their time is at most half_way_time and backward labels while they can be
+  // started after it. Defaults to half way between the initial time and the latest possible arrival time.
+  std::optional<int> half_way_time;
+};
+
+// find_bidirectional_solutions finds the same nondominated end states as find_ping_pong_solutions, but extends labels
+// both forward from the source and backward from the target, each only about half of the time horizon, and then joins
+// the forward and backward labels at each vertex. Since the number of labels grows exponentially with the path
+// length, the two half searches create far fewer labels than a full forward search on larger instances.
+// The time changes of all edges must be nonnegative.
+template <int Capacity>
+BasicSolutions<Capacity> find_bidirectional_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const BidirectionalOptions &options = {}
+);
+
+template <int Capacity>
+BasicSolutions<Capacity> find_bidirectional_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const BidirectionalOptions &options = {}
+);
+
+} // namespace perf_rcsp
+
+#endif // BIDIRECTIONAL_H
@@ -0,0 +1,176 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "completion_bounds.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace perf_rcsp {
+
+template <int Capacity>
+void compute_completion_bounds(const BasicCsrGraph<Capacity> &g, Index target_index, CompletionBounds &bounds) {
+  const size_t vertex_count = g.vertex_count();
+  const InEdges in_edges(g);
+  auto data_of = [&g](const EdgeLocation &e) -> const auto & {
+    return g.out_edge_data(e.source_vertex_index)[e.out_edge_index];
+  };
+
+  // Latest departure times: the target is reached by any time, and the best in edge of a vertex is the one that
+  // allows the latest departure. Since the time changes are nonnegative, a vertex's value is final when it is popped.
+  auto &latest_departure_times = bounds.latest_departure_times;
+  latest_departure_times.assign(vertex_count, std::numeric_limits<int>::min());
+  latest_departure_times[target_index] = std::numeric_limits<int>::max();
+  std::priority_queue<std::pair<int, Index>> latest_queue;
+  latest_queue.emplace(latest_departure_times[target_index], target_index);
+  while (!latest_queue.empty()) {
+    const auto [latest_departure_time, w] = latest_queue.top();
+    latest_queue.pop();
+    if (latest_departure_time != latest_departure_times[w]) {
+      continue; // stale
+    }
+    for (const auto &e : in_edges.of(w)) {
+      const auto &data = data_of(e);
+      ASSERT_ALWAYS(data.time_change >= 0);
+      if (data.earliest_time > latest_departure_time - data.time_change) {
+        continue; // the edge does not end before earliest_time + time_change, which is too late
+      }
+      const int candidate = std::min(data.latest_time, latest_departure_time - data.time_change);
+      if (candidate > latest_departure_times[e.source_vertex_index]) {
+        latest_departure_times[e.source_vertex_index] = candidate;
+        latest_queue.emplace(candidate, e.source_vertex_index);
+      }
+    }
+  }
+
+  // Energy requirements: the energy before an edge must cover the edge and the requirement after it. Chargers make
+  // the graph have "negative" edges, so the requirements are corrected until they no longer decrease.
+  auto &energy_requirements = bounds.energy_requirements;
+  energy_requirements.assign(vertex_count, std::numeric_limits<int>::max());
+  energy_requirements[target_index] = 0;
+  std::vector<Index> energy_queue = {target_index};
+  std::vector<uint8_t> in_energy_queue(vertex_count, 0);
+  in_energy_queue[target_index] = 1;
+  for (size_t head = 0; head < energy_queue.size(); ++head) {
+    const Index w = energy_queue[head];
+    in_energy_queue[w] = 0;
+    for (const auto &e : in_edges.of(w)) {
+      const int candidate = std::max(0, energy_requirements[w] - data_of(e).energy_change);
+      if (candidate < energy_requirements[e.source_vertex_index]) {
+        energy_requirements[e.source_vertex_index] = candidate;
+        if (!in_energy_queue[e.source_vertex_index]) {
+          in_energy_queue[e.source_vertex_index] = 1;
+          energy_queue.push_back(e.source_vertex_index);
+        }
+      }
+    }
+  }
+
+  // Cost lower bounds: only meaningful if the negative costs are on deliveries, which are made at most once each. A
+  // delivery may be on several edges, so only its cheapest edge is counted.
+  auto &cost_lower_bounds = bounds.cost_lower_bounds;
+  std::array<int, Capacity> negative_delivery_costs{};
+  bool repeatable_negative_costs = false;
+  for (Index v = 0; v < vertex_count; ++v) {
+    for (const auto &data : g.out_edge_data(v)) {
+      if (data.cost_change >= 0) {
+        continue;
+      }
+      if (data.delivery_index < not_a_delivery_marker<Capacity>) {
+        auto &delivery_cost = negative_delivery_costs[data.delivery_index];
+        delivery_cost = std::min(delivery_cost, data.cost_change);
+      } else {
+        repeatable_negative_costs = true;
+      }
+    }
+  }
+  cost_lower_bounds.assign(vertex_count, CompletionBounds::no_cost_lower_bound);
+  if (repeatable_negative_costs) {
+    // The target has no out edges, so the cost upper bound still applies to the labels there.
+    cost_lower_bounds[target_index] = 0;
+    return;
+  }
+  constexpr int unreachable = std::numeric_limits<int>::max();
+  std::vector<int> distances(vertex_count, unreachable);
+  distances[target_index] = 0;
+  std::priority_queue<std::pair<int, Index>, std::vector<std::pair<int, Index>>, std::greater<>> cost_queue;
+  cost_queue.emplace(0, target_index);
+  while (!cost_queue.empty()) {
+    const auto [distance, w] = cost_queue.top();
+    cost_queue.pop();
+    if (distance != distances[w]) {
+      continue; // stale
+    }
+    for (const auto &e : in_edges.of(w)) {
+      const int candidate = distance + std::max(0, data_of(e).cost_change);
+      if (candidate < distances[e.source_vertex_index]) {
+        distances[e.source_vertex_index] = candidate;
+        cost_queue.emplace(candidate, e.source_vertex_index);
+      }
+    }
+  }
+
+  // The deliveries with negative costs that a path from each vertex to the target can still make, by label correcting
+  // since the graph has cycles, so that e.g. the bound at the target counts none of them. The sets start empty, so each
+  // vertex that reaches the target is queued once up front.
+  std::vector<BasicDeliverySet<Capacity>> negative_deliveries(vertex_count);
+  std::vector<Index> delivery_queue;
+  std::vector<uint8_t> in_delivery_queue(vertex_count, 0);
+  for (Index v = 0; v < vertex_count; ++v) {
+    if (distances[v] != unreachable) {
+      delivery_queue.push_back(v);
+      in_delivery_queue[v] = 1;
+    }
+  }
+  for (size_t head = 0; head < delivery_queue.size(); ++head) {
+    const Index w = delivery_queue[head];
+    in_delivery_queue[w] = 0;
+    for (const auto &e : in_edges.of(w)) {
+      const auto &data = data_of(e);
+      auto candidate = negative_deliveries[w];
+      if (data.cost_change < 0 && data.delivery_index < not_a_delivery_marker<Capacity>) {
+        candidate.set(data.delivery_index);
+      }
+      candidate |= negative_deliveries[e.source_vertex_index];
+      if (candidate != negative_deliveries[e.source_vertex_index]) {
+        negative_deliveries[e.source_vertex_index] = candidate;
+        if (!in_delivery_queue[e.source_vertex_index]) {
+          in_delivery_queue[e.source_vertex_index] = 1;
+          delivery_queue.push_back(e.source_vertex_index);
+        }
+      }
+    }
+  }
+  for (Index v = 0; v < vertex_count; ++v) {
+    // Unreachable vertices are already pruned by the latest departure times.
+    if (distances[v] != unreachable) {
+      cost_lower_bounds[v] = distances[v];
+      for (int delivery_index = 0; delivery_index < Capacity; ++delivery_index) {
+        if (negative_deliveries[v].test(delivery_index)) {
+          cost_lower_bounds[v] += negative_delivery_costs[delivery_index];
+        }
+      }
+    }
+  }
+}
+
+#define INSTANTIATE_COMPUTE_COMPLETION_BOUNDS(CAPACITY)                                                                \
+  template void compute_completion_bounds(const BasicCsrGraph<CAPACITY> &, Index, CompletionBounds &);
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_COMPUTE_COMPLETION_BOUNDS)
+
+} // namespace perf_rcsp
@@ -0,0 +1,65 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef COMPLETION_BOUNDS_H
+#define COMPLETION_BOUNDS_H
+
+#include "csr_graph.h"
+#include "vrp_model.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace perf_rcsp {
+
+// CompletionBounds holds, for each vertex, bounds on what a label at the vertex needs to still reach the target. Each
+// bound relaxes the other resources, e.g. the energy requirement ignores the time windows, so a label that fails a
+// bound can never be completed, and neither can the labels that it dominates.
+struct CompletionBounds {
+  static constexpr int no_cost_lower_bound = std::numeric_limits<int>::min();
+
+  // The latest time at which the target can still be reached within the latest times of the edges.
+  std::vector<int> latest_departure_times;
+  // The least energy with which the target can be reached without running out of energy, at least 0.
+  std::vector<int> energy_requirements;
+  // A lower bound on the cost of the rest of the path, or no_cost_lower_bound if there is none because edges that are
+  // not deliveries, and hence can be repeated, have negative costs.
+  std::vector<int> cost_lower_bounds;
+
+  // Return true if a label with state at vertex_index may be completed into a path that ends with a cost below
+  // cost_upper_bound.
+  template <int Capacity>
+  [[nodiscard]] bool may_complete(const BasicState<Capacity> &state, Index vertex_index, int cost_upper_bound) const {
+    if (state.time > latest_departure_times[vertex_index] || state.energy < energy_requirements[vertex_index]) {
+      return false;
+    }
+    const int cost_lower_bound = cost_lower_bounds[vertex_index];
+    return cost_lower_bound == no_cost_lower_bound ||
+           static_cast<int64_t>(state.cost) + cost_lower_bound < static_cast<int64_t>(cost_upper_bound);
+  }
+};
+
+// Computes the bounds over the reversed graph: the latest departure times with a max-min Dijkstra search, the energy
+// requirements by label correcting and the cost lower bounds with a Dijkstra search in which each delivery is counted
+// at its cost if nonnegative and otherwise up front, as if all deliveries with negative costs that can still be made
+// from the vertex were made, each at the cost of its cheapest edge.
+// The time changes of all edges must be nonnegative. Reuses the capacity of bounds.
+template <int Capacity>
+void compute_completion_bounds(const BasicCsrGraph<Capacity> &g, Index target_index, CompletionBounds &bounds);
+
+} // namespace perf_rcsp
+
+#endif // COMPLETION_BOUNDS_H
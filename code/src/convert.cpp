@@ -21,15 +21,15 @@
 #include <boost/range/iterator_range.hpp>
 
 namespace perf_rcsp {
-Graph convert_to_graph(const BoostGraph &boost_graph) {
-  Graph graph;
+template <int Capacity> BasicGraph<Capacity> convert_to_graph(const BasicBoostGraph<Capacity> &boost_graph) {
+  BasicGraph<Capacity> graph;
   for (auto vertex_index : boost::make_iterator_range(boost::vertices(boost_graph))) {
     const BoostVertex &vertex = boost_graph[vertex_index];
     graph.add_vertex(vertex.site);
   }
 
   for (const auto &edge_description : boost::make_iterator_range(boost::edges(boost_graph))) {
-    const ExtensionData &extension_data = boost_graph[edge_description];
+    const BasicExtensionData<Capacity> &extension_data = boost_graph[edge_description];
     const Index source_vertex_index = boost_graph[boost::source(edge_description, boost_graph)].index;
     const Index target_vertex_index = boost_graph[boost::target(edge_description, boost_graph)].index;
     graph.add_edge(source_vertex_index, target_vertex_index, extension_data);
@@ -38,8 +38,8 @@ Graph convert_to_graph(const BoostGraph &boost_graph) {
   return graph;
 }
 
-BoostGraph convert_to_boost_graph(const Graph &graph) {
-  BoostGraph boost_graph;
+template <int Capacity> BasicBoostGraph<Capacity> convert_to_boost_graph(const BasicGraph<Capacity> &graph) {
+  BasicBoostGraph<Capacity> boost_graph;
 
   for (const auto &v : graph.get_vertices()) {
     boost::add_vertex(BoostVertex{v.index, v.site}, boost_graph);
@@ -54,4 +54,9 @@ BoostGraph convert_to_boost_graph(const Graph &graph) {
   return boost_graph;
 }
 
+#define INSTANTIATE_CONVERT(CAPACITY)                                                                                  \
+  template BasicGraph<CAPACITY> convert_to_graph(const BasicBoostGraph<CAPACITY> &);                                   \
+  template BasicBoostGraph<CAPACITY> convert_to_boost_graph(const BasicGraph<CAPACITY> &);
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_CONVERT)
+
 } // namespace perf_rcsp
@@ -23,9 +23,10 @@
 #include "rcsp_boost_graph.h"
 
 namespace perf_rcsp {
-Graph convert_to_graph(const BoostGraph &boost_graph);
+// The conversions are instantiated for each capacity in PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY.
+template <int Capacity> BasicGraph<Capacity> convert_to_graph(const BasicBoostGraph<Capacity> &boost_graph);
 
-BoostGraph convert_to_boost_graph(const Graph &graph);
+template <int Capacity> BasicBoostGraph<Capacity> convert_to_boost_graph(const BasicGraph<Capacity> &graph);
 
 } // namespace perf_rcsp
 
@@ -0,0 +1,222 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "graph.h"
+#include "vrp_model.h"
+
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace perf_rcsp {
+
+// BasicCsrGraph is a frozen compressed sparse row copy of a BasicGraph: the out edges of all vertices are stored
+// contiguously, vertex by vertex, instead of in one heap allocated vector per vertex. The fields that the label loop
+// reads (targets and hot extension data) are stored apart from the cold ones (extension indices).
+// The out edges of a vertex keep their order, so an out_edge_index means the same in both graphs.
+// The arrays are read through spans that refer either to the graph's own vectors or, for a view, to arrays owned
+// elsewhere, e.g. by a mapped graph file, see view.
+template <int Capacity> class BasicCsrGraph {
+  std::vector<Index> owned_offsets = {0};
+  std::vector<Index> owned_targets = {};
+  std::vector<BasicHotExtensionData<Capacity>> owned_hot_data = {};
+  std::vector<Index> owned_extension_indices = {};
+  bool is_view = false;
+  std::span<const Index> offsets = owned_offsets; // the out edges of vertex v are [offsets[v], offsets[v + 1])
+  std::span<const Index> targets = owned_targets;
+  std::span<const BasicHotExtensionData<Capacity>> hot_data = owned_hot_data;
+  std::span<const Index> extension_indices = owned_extension_indices;
+
+  void point_to_owned_arrays() {
+    is_view = false;
+    offsets = owned_offsets;
+    targets = owned_targets;
+    hot_data = owned_hot_data;
+    extension_indices = owned_extension_indices;
+  }
+
+  void clear_owned_arrays() {
+    owned_offsets.clear();
+    owned_targets.clear();
+    owned_hot_data.clear();
+    owned_extension_indices.clear();
+    owned_offsets.push_back(0);
+  }
+
+  // Points to the arrays of other if it is a view and otherwise to the owned arrays, which are a copy of other's.
+  void adopt_arrays_of(const BasicCsrGraph &other) {
+    if (other.is_view) {
+      is_view = true;
+      offsets = other.offsets;
+      targets = other.targets;
+      hot_data = other.hot_data;
+      extension_indices = other.extension_indices;
+    } else {
+      point_to_owned_arrays();
+    }
+  }
+
+public:
+  static constexpr int capacity = Capacity;
+
+  BasicCsrGraph() = default;
+  explicit BasicCsrGraph(const BasicGraph<Capacity> &g) { assign(g); }
+
+  // A copy of a view is a view of the same arrays.
+  BasicCsrGraph(const BasicCsrGraph &other) { *this = other; }
+  BasicCsrGraph(BasicCsrGraph &&other) noexcept { *this = std::move(other); }
+  BasicCsrGraph &operator=(const BasicCsrGraph &other) {
+    if (this != &other) {
+      owned_offsets = other.owned_offsets;
+      owned_targets = other.owned_targets;
+      owned_hot_data = other.owned_hot_data;
+      owned_extension_indices = other.owned_extension_indices;
+      adopt_arrays_of(other);
+    }
+    return *this;
+  }
+  BasicCsrGraph &operator=(BasicCsrGraph &&other) noexcept {
+    if (this != &other) {
+      owned_offsets = std::move(other.owned_offsets);
+      owned_targets = std::move(other.owned_targets);
+      owned_hot_data = std::move(other.owned_hot_data);
+      owned_extension_indices = std::move(other.owned_extension_indices);
+      adopt_arrays_of(other);
+      other.clear_owned_arrays();
+      other.point_to_owned_arrays();
+    }
+    return *this;
+  }
+
+  // Returns a graph that refers to the given arrays, laid out as the ones of a BasicCsrGraph, instead of owning a copy
+  // of them. The arrays must outlive the graph and its copies. The assign functions replace a view with owned arrays.
+  static BasicCsrGraph view(
+    std::span<const Index> offsets,
+    std::span<const Index> targets,
+    std::span<const BasicHotExtensionData<Capacity>> hot_data,
+    std::span<const Index> extension_indices
+  ) {
+    ASSERT_ALWAYS(!offsets.empty() && offsets.front() == 0 && offsets.back() == targets.size());
+    ASSERT_ALWAYS(hot_data.size() == targets.size() && extension_indices.size() == targets.size());
+    BasicCsrGraph g;
+    g.is_view = true;
+    g.offsets = offsets;
+    g.targets = targets;
+    g.hot_data = hot_data;
+    g.extension_indices = extension_indices;
+    return g;
+  }
+
+  // Replaces the contents with a copy of g. Reuses the capacity of the arrays.
+  void assign(const BasicGraph<Capacity> &g) {
+    clear_owned_arrays();
+    for (const auto &v : g.get_vertices()) {
+      for (const auto &e : v.out_edges) {
+        owned_targets.push_back(e.vertex_index);
+        owned_hot_data.emplace_back(e.data);
+        owned_extension_indices.push_back(e.data.index);
+      }
+      owned_offsets.push_back(owned_targets.size());
+    }
+    point_to_owned_arrays();
+  }
+
+  // Replaces the contents with the out edges of g for which keep(vertex_index, out_edge_index) is true, in the same
+  // order. Since the kept out edges are renumbered, out_edge_indices[edge_position(e)] is set to the out_edge_index
+  // in g of each out edge e of the copy.
+  template <typename Keep>
+  void assign_subgraph(const BasicCsrGraph &g, Keep &&keep, std::vector<Index> &out_edge_indices) {
+    ASSERT_ALWAYS(&g != this);
+    clear_owned_arrays();
+    out_edge_indices.clear();
+    for (Index v = 0; v < g.vertex_count(); ++v) {
+      for (Index out_edge_index = 0; out_edge_index < g.out_edge_targets(v).size(); ++out_edge_index) {
+        if (!keep(v, out_edge_index)) {
+          continue;
+        }
+        owned_targets.push_back(g.out_edge_targets(v)[out_edge_index]);
+        owned_hot_data.push_back(g.out_edge_data(v)[out_edge_index]);
+        owned_extension_indices.push_back(g.extension_index(EdgeLocation{v, out_edge_index}));
+        out_edge_indices.push_back(out_edge_index);
+      }
+      owned_offsets.push_back(owned_targets.size());
+    }
+    point_to_owned_arrays();
+  }
+
+  [[nodiscard]] size_t vertex_count() const { return offsets.size() - 1; }
+  [[nodiscard]] size_t edge_count() const { return targets.size(); }
+
+  // The out edges of a vertex as parallel spans indexed by out_edge_index.
+  [[nodiscard]] std::span<const Index> out_edge_targets(Index vertex_index) const {
+    return {targets.data() + offsets[vertex_index], targets.data() + offsets[vertex_index + 1]};
+  }
+  [[nodiscard]] std::span<const BasicHotExtensionData<Capacity>> out_edge_data(Index vertex_index) const {
+    return {hot_data.data() + offsets[vertex_index], hot_data.data() + offsets[vertex_index + 1]};
+  }
+  // The position of an out edge in the arrays of all out edges, i.e. in [0, edge_count()).
+  [[nodiscard]] Index edge_position(const EdgeLocation &edge_location) const {
+    return offsets[edge_location.source_vertex_index] + edge_location.out_edge_index;
+  }
+  [[nodiscard]] Index extension_index(const EdgeLocation &edge_location) const {
+    return extension_indices[edge_position(edge_location)];
+  }
+
+  // The whole arrays, e.g. to write them to a graph file.
+  [[nodiscard]] std::span<const Index> all_offsets() const { return offsets; }
+  [[nodiscard]] std::span<const Index> all_targets() const { return targets; }
+  [[nodiscard]] std::span<const BasicHotExtensionData<Capacity>> all_out_edge_data() const { return hot_data; }
+  [[nodiscard]] std::span<const Index> all_extension_indices() const { return extension_indices; }
+};
+using CsrGraph = BasicCsrGraph<N_DELIVERIES>;
+
+// InEdges lists the in edges of each vertex of a BasicCsrGraph, as the locations of the corresponding out edges, for
+// searches over the reversed graph.
+class InEdges {
+  std::vector<Index> offsets; // the in edges of vertex w are [offsets[w], offsets[w + 1])
+  std::vector<EdgeLocation> edges;
+
+public:
+  template <int Capacity>
+  explicit InEdges(const BasicCsrGraph<Capacity> &g)
+    : offsets(g.vertex_count() + 1, 0), edges(g.edge_count()) {
+    for (Index v = 0; v < g.vertex_count(); ++v) {
+      for (Index w : g.out_edge_targets(v)) {
+        ++offsets[w + 1];
+      }
+    }
+    for (Index w = 0; w < g.vertex_count(); ++w) {
+      offsets[w + 1] += offsets[w];
+    }
+    std::vector<Index> fill(offsets.begin(), offsets.end() - 1);
+    for (Index v = 0; v < g.vertex_count(); ++v) {
+      const auto targets = g.out_edge_targets(v);
+      for (Index out_edge_index = 0; out_edge_index < targets.size(); ++out_edge_index) {
+        edges[fill[targets[out_edge_index]]++] = EdgeLocation{v, out_edge_index};
+      }
+    }
+  }
+
+  [[nodiscard]] std::span<const EdgeLocation> of(Index vertex_index) const {
+    return {edges.data() + offsets[vertex_index], edges.data() + offsets[vertex_index + 1]};
+  }
+};
+
+} // namespace perf_rcsp
+
+#endif // CSR_GRAPH_H
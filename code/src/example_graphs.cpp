@@ -20,27 +20,50 @@
 
 #include <algorithm>
 #include <boost/graph/adjacency_list.hpp>
-#include <boost/numeric/conversion/cast.hpp>
 #include <cmath>
 #include <random>
 #include <ranges>
+#include <utility>
 #include <vector>
 
 namespace perf_rcsp {
 namespace views = std::ranges::views;
 
+// Tracks the taken integer positions of a square grid, so that finding a free position takes constant time per draw
+// instead of a search of the sites placed so far.
+class TakenPositions {
+  int side_length;
+  std::vector<bool> taken;
+
+public:
+  explicit TakenPositions(int side_length)
+    : side_length(side_length), taken(static_cast<size_t>(side_length) * side_length) {}
+
+  // Takes the position of p and returns true if it was free.
+  bool take(const Site &p) {
+    const size_t position = static_cast<size_t>(p.y) * side_length + static_cast<size_t>(p.x);
+    ASSERT_ALWAYS(position < taken.size());
+    if (taken[position]) {
+      return false;
+    }
+    taken[position] = true;
+    return true;
+  }
+};
+
 std::vector<Site> create_sites(const int sites_count, std::mt19937 &gen) {
   std::vector<Site> sites;
   // Calculated a small grid that is big enough so it will not be difficult
   // to find unique random positions for sites.
   const int grid_side_length = 10 + std::sqrt(2 * sites_count);
+  TakenPositions taken_positions(grid_side_length);
   std::uniform_int_distribution<> coordinate_distribution(0, grid_side_length - 1);
   while (sites.size() < sites_count) {
     bool found_empty_position = false;
     // Use fixed iteration loop to avoid infinite loop.
     for (int i = 0; i < 100000; i++) {
       if (Site p = {static_cast<float>(coordinate_distribution(gen)), static_cast<float>(coordinate_distribution(gen))};
-          !std::ranges::contains(sites, p)) {
+          taken_positions.take(p)) {
         sites.emplace_back(p);
         found_empty_position = true;
         break;
@@ -51,11 +74,41 @@ std::vector<Site> create_sites(const int sites_count, std::mt19937 &gen) {
 
   return sites;
 }
-bool add_site_to_site_travel_edges(
+
+// Places the sites in clusters of about 5 sites, each in a 3 by 3 square, with the squares' corners on a grid with a
+// spacing of 12.
+std::vector<Site> create_clustered_sites(const int sites_count, std::mt19937 &gen) {
+  const int cluster_count = (sites_count + 4) / 5;
+  const int clusters_per_side = static_cast<int>(std::ceil(std::sqrt(cluster_count)));
+  TakenPositions taken_positions(12 * clusters_per_side);
+  std::uniform_int_distribution<> offset_distribution(0, 2);
+  std::vector<Site> sites;
+  while (std::cmp_less(sites.size(), sites_count)) {
+    // Fill the clusters in turn, so that each gets about the same number of sites.
+    const int cluster = static_cast<int>(sites.size()) % cluster_count;
+    const float corner_x = 12.0f * static_cast<float>(cluster % clusters_per_side);
+    const float corner_y = 12.0f * static_cast<float>(cluster / clusters_per_side);
+    bool found_empty_position = false;
+    for (int i = 0; i < 100000; i++) {
+      if (Site p = {corner_x + static_cast<float>(offset_distribution(gen)),
+                    corner_y + static_cast<float>(offset_distribution(gen))};
+          taken_positions.take(p)) {
+        sites.emplace_back(p);
+        found_empty_position = true;
+        break;
+      }
+    }
+    ASSERT_ALWAYS(found_empty_position);
+  }
+  return sites;
+}
+
+template <int Capacity, typename AddEdge>
+void add_site_to_site_travel_edges(
   const std::vector<Site> &sites,
   const int latest_time,
   Index &extension_index,
-  BoostGraph &graph
+  AddEdge &&add_edge
 ) {
   auto enumerated_sites = views::enumerate(sites);
   for (auto [from_vertex_index, from_site] : enumerated_sites) {
@@ -67,60 +120,119 @@ bool add_site_to_site_travel_edges(
       float y_diff = (from_site.y - to_site.y);
       float distance = std::sqrt(10 * (x_diff * x_diff + y_diff * y_diff));
       ASSERT_ALWAYS(0 < distance);
-      boost::add_edge(
+      add_edge(
         from_vertex_index, to_vertex_index,
-        ExtensionData(extension_index++, 0, latest_time, 2 * distance, distance, -distance, NOT_A_DELIVERY_MARKER),
-        graph
+        BasicExtensionData<Capacity>(
+          extension_index++, 0, latest_time, 2 * distance, distance, -distance, not_a_delivery_marker<Capacity>
+        )
       );
     }
   }
-  return false;
 }
 
-void generate(const int sites_count, const int seed, SourceTargetBoostGraph &s_t_graph) {
+// Builds the instance with add_vertex(site), which adds the vertices in order of their indices, and
+// add_edge(source_vertex_index, target_vertex_index, data), so that the BoostGraph and the Graph of an instance have
+// the same vertices and the same out edges in the same order.
+template <int Capacity, typename AddVertex, typename AddEdge>
+void build_instance(
+  const InstanceFamily family,
+  const int sites_count,
+  const int seed,
+  AddVertex &&add_vertex,
+  AddEdge &&add_edge
+) {
+  using ExtensionData = BasicExtensionData<Capacity>;
+  constexpr int not_a_delivery = not_a_delivery_marker<Capacity>;
   ASSERT_ALWAYS(1 <= sites_count);
-  s_t_graph.source_vertex = 0;
-  s_t_graph.target_vertex = sites_count;
-  auto &graph = s_t_graph.graph;
-  graph.clear();
 
   std::mt19937 gen(seed);
-  const std::vector<Site> sites = create_sites(sites_count, gen);
+  const std::vector<Site> sites =
+    family == InstanceFamily::clustered ? create_clustered_sites(sites_count, gen) : create_sites(sites_count, gen);
 
   // add one vertex for each site
-  for (auto [index, site] : views::enumerate(sites)) {
-    boost::add_vertex(BoostVertex{boost::numeric_cast<Index>(index), site}, graph);
+  for (const Site &site : sites) {
+    add_vertex(site);
   }
 
   // add one extra vertex to be used as the target vertex and offset position for visualization
-  boost::add_vertex(BoostVertex{sites.size(), Site{sites[0].x + 0.5f, sites[0].y + 0.5f}}, graph);
+  add_vertex(Site{sites[0].x + 0.5f, sites[0].y + 0.5f});
 
   const int latest_time = 100;
   Index extension_index = 0; // also the edge index
   // always add charger/fueling edge at index 0
-  boost::add_edge(0, 0, ExtensionData(extension_index++, 0, latest_time, 3, 2, 4, NOT_A_DELIVERY_MARKER), graph);
+  add_edge(0, 0, ExtensionData(extension_index++, 0, latest_time, 3, 2, 4, not_a_delivery));
 
   // add more chargers/fueling edges randomly
   std::uniform_real_distribution<> charger_distribution(0, 1);
   for (Index i = 1; i < sites_count; ++i) {
-    if (charger_distribution(gen) < 0.15) {
+    // Draw for every site, so that the other families have the same sites as the uniform one.
+    if (charger_distribution(gen) < 0.15 && family != InstanceFamily::scarce_chargers) {
       // add charger/fueling at index
-      boost::add_edge(i, i, ExtensionData{extension_index++, 0, latest_time, 3, 2, 4, NOT_A_DELIVERY_MARKER}, graph);
+      add_edge(i, i, ExtensionData{extension_index++, 0, latest_time, 3, 2, 4, not_a_delivery});
     }
   }
 
   // add delivery edges
+  const int window_width = 10;
+  std::uniform_int_distribution<> window_start_distribution(0, latest_time - window_width);
   for (Index i = 1; i < sites_count; ++i) {
-    ASSERT_ALWAYS(i < N_DELIVERIES);
-    boost::add_edge(i, i, ExtensionData(extension_index++, 0, latest_time, 0, 0, 0, static_cast<int>(i)), graph);
+    ASSERT_ALWAYS(i < Capacity);
+    int earliest_time = 0;
+    int latest_delivery_time = latest_time;
+    if (family == InstanceFamily::tight_windows) {
+      earliest_time = window_start_distribution(gen);
+      latest_delivery_time = earliest_time + window_width;
+    }
+    add_edge(i, i, ExtensionData(extension_index++, earliest_time, latest_delivery_time, 0, 0, 0, static_cast<int>(i)));
   }
 
-  add_site_to_site_travel_edges(sites, latest_time, extension_index, graph);
+  add_site_to_site_travel_edges<Capacity>(sites, latest_time, extension_index, add_edge);
 
   // add a structural edge from source (index = 0) to target (index = sites_count)
-  boost::add_edge(
-    0, sites_count, ExtensionData(extension_index++, 0, latest_time, 0, 0, 0, NOT_A_DELIVERY_MARKER), graph
+  add_edge(0, sites_count, ExtensionData(extension_index++, 0, latest_time, 0, 0, 0, not_a_delivery));
+}
+
+template <int Capacity>
+void generate(const int sites_count, const int seed, BasicSourceTargetBoostGraph<Capacity> &s_t_graph) {
+  generate(InstanceFamily::uniform, sites_count, seed, s_t_graph);
+}
+
+template <int Capacity>
+void generate(
+  const InstanceFamily family,
+  const int sites_count,
+  const int seed,
+  BasicSourceTargetBoostGraph<Capacity> &s_t_graph
+) {
+  s_t_graph.source_vertex = 0;
+  s_t_graph.target_vertex = sites_count;
+  auto &graph = s_t_graph.graph;
+  graph.clear();
+  Index vertex_count = 0;
+  build_instance<Capacity>(
+    family, sites_count, seed,
+    [&](const Site &site) { boost::add_vertex(BoostVertex{vertex_count++, site}, graph); },
+    [&](Index source_vertex_index, Index target_vertex_index, const BasicExtensionData<Capacity> &data) {
+      boost::add_edge(source_vertex_index, target_vertex_index, data, graph);
+    }
   );
 }
 
+template <int Capacity> BasicGraph<Capacity> generate_graph(InstanceFamily family, int sites_count, int seed) {
+  BasicGraph<Capacity> graph;
+  build_instance<Capacity>(
+    family, sites_count, seed, [&](const Site &site) { graph.add_vertex(site); },
+    [&](Index source_vertex_index, Index target_vertex_index, const BasicExtensionData<Capacity> &data) {
+      graph.add_edge(source_vertex_index, target_vertex_index, data);
+    }
+  );
+  return graph;
+}
+
+#define INSTANTIATE_GENERATE(CAPACITY)                                                                                 \
+  template void generate(int, int, BasicSourceTargetBoostGraph<CAPACITY> &);                                           \
+  template void generate(InstanceFamily, int, int, BasicSourceTargetBoostGraph<CAPACITY> &);                           \
+  template BasicGraph<CAPACITY> generate_graph(InstanceFamily, int, int);
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_GENERATE)
+
 } // namespace perf_rcsp
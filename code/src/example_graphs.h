@@ -19,6 +19,7 @@
 #ifndef EXAMPLE_GRAPHS_H
 #define EXAMPLE_GRAPHS_H
 
+#include "graph.h"
 #include "rcsp_boost_graph.h"
 
 namespace perf_rcsp {
@@ -28,7 +29,32 @@ namespace perf_rcsp {
 //
 // Note: use a reference instead of returning a SourceTargetBoostGraph, since
 // it is unclear if copying or moving boost::graph works correctly.
-void generate(int sites_count, int seed, SourceTargetBoostGraph &s_t_graph);
+//
+// Every site except the first has a delivery, so sites_count must be at most the capacity. generate is
+// instantiated for each capacity in PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY.
+template <int Capacity> void generate(int sites_count, int seed, BasicSourceTargetBoostGraph<Capacity> &s_t_graph);
+
+// The structured families of instances that generate can make, e.g. to benchmark the solvers on more than the uniform
+// instances. The other families change one aspect of the uniform instances.
+enum class InstanceFamily {
+  // The sites are placed uniformly at random on a small grid, as by generate above.
+  uniform,
+  // The sites are placed in a few small clusters that are far apart, so that the travel within a cluster is cheap.
+  clustered,
+  // Each delivery can only be made in a random time window of width 10 instead of any time.
+  tight_windows,
+  // Only the first site has a charger.
+  scarce_chargers,
+};
+
+// Same as above but for an instance of family. The uniform family gives the instances of generate above.
+template <int Capacity>
+void generate(InstanceFamily family, int sites_count, int seed, BasicSourceTargetBoostGraph<Capacity> &s_t_graph);
+
+// Same instance as generate above, but built as a BasicGraph directly, i.e. without the BoostGraph and its conversion,
+// which is several times faster for large instances. The source vertex is 0 and the target vertex is sites_count.
+// Each instance only depends on its arguments, so instances can be generated concurrently, e.g. for a corpus.
+template <int Capacity> BasicGraph<Capacity> generate_graph(InstanceFamily family, int sites_count, int seed);
 
 } // namespace perf_rcsp
 
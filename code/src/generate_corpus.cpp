@@ -0,0 +1,144 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "example_graphs.h"
+#include "graph_file.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <spdlog/fmt/fmt.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace perf_rcsp;
+
+constexpr std::array<std::pair<std::string_view, InstanceFamily>, 4> family_names = {{
+  {"uniform", InstanceFamily::uniform},
+  {"clustered", InstanceFamily::clustered},
+  {"tight_windows", InstanceFamily::tight_windows},
+  {"scarce_chargers", InstanceFamily::scarce_chargers},
+}};
+
+InstanceFamily parse_family(std::string_view name) {
+  for (const auto &[family_name, family] : family_names) {
+    if (family_name == name) {
+      return family;
+    }
+  }
+  throw std::invalid_argument(fmt::format("unknown instance family {}", name));
+}
+
+int parse_int(const char *argument, std::string_view name, int min) {
+  size_t parsed_size = 0;
+  const int value = std::stoi(argument, &parsed_size);
+  if (argument[parsed_size] != '\0' || value < min) {
+    throw std::invalid_argument(fmt::format("the {} must be an integer of at least {}", name, min));
+  }
+  return value;
+}
+
+// Generates and writes the instances of the seeds concurrently, each task one instance, so that only one instance per
+// thread is in memory. Each instance only depends on its seed, so the files are the same for any number of threads.
+template <int Capacity>
+void write_corpus(
+  const std::filesystem::path &directory,
+  std::string_view family_name,
+  InstanceFamily family,
+  int sites_count,
+  int first_seed,
+  int seed_count,
+  ThreadPool &pool
+) {
+  std::vector<std::optional<std::string>> errors(seed_count);
+  pool.parallel_for(seed_count, [&](size_t seed_index, size_t) {
+    const int seed = first_seed + static_cast<int>(seed_index);
+    try {
+      const auto graph = generate_graph<Capacity>(family, sites_count, seed);
+      const auto path = directory / fmt::format("{}_{}_{}.graph", family_name, sites_count, seed);
+      write_graph_file(path, graph, 0, sites_count);
+    } catch (const std::exception &e) {
+      // The tasks must not throw, so the errors are reported after all tasks have run.
+      errors[seed_index] = e.what();
+    }
+  });
+  for (const auto &error : errors) {
+    if (error) {
+      throw std::runtime_error(*error);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    if (argc != 6 && argc != 7) {
+      if (argc == 0) {
+        throw std::invalid_argument("argc is 0");
+      }
+      std::filesystem::path program_path(argv[0]);
+      std::string program_name = program_path.filename().string();
+      fmt::println(
+        R"(
+{0} writes a corpus of generated instances as graph files, one per seed, named <family>_<sites count>_<seed>.graph.
+The instances are generated in parallel, and the delivery capacity of the files is the smallest one that fits the
+sites. The families are uniform, clustered, tight_windows and scarce_chargers.
+
+Usage: {0} <output directory> <family> <sites count> <first seed> <seed count> [<threads>]
+example: {0} corpus uniform 100 1 1000 8)",
+        program_name
+      );
+      return 2;
+    }
+
+    const std::filesystem::path directory(argv[1]);
+    const std::string_view family_name(argv[2]);
+    const InstanceFamily family = parse_family(family_name);
+    const int sites_count = parse_int(argv[3], "sites count", 1);
+    const int first_seed = parse_int(argv[4], "first seed", 0);
+    const int seed_count = parse_int(argv[5], "seed count", 1);
+    ThreadPool pool(
+      argc == 7 ? parse_int(argv[6], "number of threads", 1) : std::max(1u, std::thread::hardware_concurrency())
+    );
+
+    std::filesystem::create_directories(directory);
+    // Every site except the first has a delivery, see generate.
+    if (sites_count <= 32) {
+      write_corpus<32>(directory, family_name, family, sites_count, first_seed, seed_count, pool);
+    } else if (sites_count <= 64) {
+      write_corpus<64>(directory, family_name, family, sites_count, first_seed, seed_count, pool);
+    } else if (sites_count <= 128) {
+      write_corpus<128>(directory, family_name, family, sites_count, first_seed, seed_count, pool);
+    } else if (sites_count <= 256) {
+      write_corpus<256>(directory, family_name, family, sites_count, first_seed, seed_count, pool);
+    } else {
+      throw std::invalid_argument("the sites count must be at most 256");
+    }
+    fmt::println("wrote {} instances to {}", seed_count, directory.string());
+  } catch (const std::exception &e) {
+    fmt::println("exception occurred: {}", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -21,38 +21,47 @@
 
 #include "vrp_model.h"
 
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace perf_rcsp {
 
-struct TargetEdge {
+template <int Capacity> struct BasicTargetEdge {
   Index vertex_index = {};
-  ExtensionData data = {};
+  BasicExtensionData<Capacity> data = {};
 };
+using TargetEdge = BasicTargetEdge<N_DELIVERIES>;
 
-struct Vertex {
+template <int Capacity> struct BasicVertex {
   Index index = -1;
   Site site = {-1, -1};
-  std::vector<TargetEdge> out_edges;
+  std::vector<BasicTargetEdge<Capacity>> out_edges;
 };
+using Vertex = BasicVertex<N_DELIVERIES>;
 
 struct EdgeLocation {
   Index source_vertex_index = 0;
   Index out_edge_index = 0;
+  auto operator<=>(const EdgeLocation &) const = default;
 };
 
-class Graph {
-  std::vector<Vertex> vertices = {};
+template <int Capacity> class BasicGraph {
+  std::vector<BasicVertex<Capacity>> vertices = {};
   std::vector<EdgeLocation> edges = {};
 
 public:
+  static constexpr int capacity = Capacity;
+
   Index add_vertex(const Site &site) {
     Index index = vertices.size();
-    vertices.emplace_back(index, site, std::vector<TargetEdge>());
+    vertices.emplace_back(index, site, std::vector<BasicTargetEdge<Capacity>>());
     return index;
   }
 
-  Index add_edge(Index source_vertex_index, Index target_vertex_index, ExtensionData data) {
+  Index add_edge(Index source_vertex_index, Index target_vertex_index, BasicExtensionData<Capacity> data) {
     ASSERT_ALWAYS(source_vertex_index < vertices.size());
     ASSERT_ALWAYS(target_vertex_index < vertices.size());
     auto &out_edges = vertices[source_vertex_index].out_edges;
@@ -61,14 +70,61 @@ public:
     return edges.size() - 1;
   }
 
-  [[nodiscard]] const ExtensionData &get_extension_data(Index edge_index) const {
+  [[nodiscard]] const BasicExtensionData<Capacity> &get_extension_data(Index edge_index) const {
     ASSERT_ALWAYS(edge_index < edges.size());
     const auto &edge_location = edges[edge_index];
     return vertices[edge_location.source_vertex_index].out_edges[edge_location.out_edge_index].data;
   }
 
-  [[nodiscard]] const std::vector<Vertex> &get_vertices() const { return vertices; }
+  [[nodiscard]] const std::vector<BasicVertex<Capacity>> &get_vertices() const { return vertices; }
+  [[nodiscard]] size_t edge_count() const { return edges.size(); }
+
+  // The functions below update the costs in place, e.g. the reduced costs between the pricing calls of column
+  // generation, so that the graph need not be rebuilt when only the duals change.
+
+  void set_cost_change(Index edge_index, int cost_change) {
+    ASSERT_ALWAYS(edge_index < edges.size());
+    edge_data(edges[edge_index]).cost_change = cost_change;
+  }
+
+  // Sets the cost_change of each edge to cost_changes[edge_index].
+  void set_cost_changes(std::span<const int> cost_changes) {
+    ASSERT_ALWAYS(cost_changes.size() == edges.size());
+    for (Index edge_index = 0; edge_index < edges.size(); ++edge_index) {
+      edge_data(edges[edge_index]).cost_change = cost_changes[edge_index];
+    }
+  }
+
+  // Sets the cost_change of each edge to cost_change_of(data) of its extension data, e.g. to look the cost up by
+  // BasicExtensionData::index.
+  template <typename CostChangeOf> void update_cost_changes(CostChangeOf &&cost_change_of) {
+    for (auto &v : vertices) {
+      for (auto &e : v.out_edges) {
+        e.data.cost_change = cost_change_of(std::as_const(e.data));
+      }
+    }
+  }
+
+  // Sets the cost_change of each edge to base_cost_changes[edge_index] minus the dual of the edge's delivery, if any.
+  // duals[delivery_index] is the dual of a delivery. The duals are copied into a table with a zero at
+  // not_a_delivery_marker, so that the edges without a delivery need no branch.
+  void apply_duals(std::span<const int> base_cost_changes, std::span<const int> duals) {
+    ASSERT_ALWAYS(base_cost_changes.size() == edges.size());
+    ASSERT_ALWAYS(duals.size() <= Capacity);
+    std::array<int, Capacity + 1> padded_duals{};
+    std::ranges::copy(duals, padded_duals.begin());
+    for (Index edge_index = 0; edge_index < edges.size(); ++edge_index) {
+      auto &data = edge_data(edges[edge_index]);
+      data.cost_change = base_cost_changes[edge_index] - padded_duals[data.delivery_index];
+    }
+  }
+
+private:
+  BasicExtensionData<Capacity> &edge_data(const EdgeLocation &edge_location) {
+    return vertices[edge_location.source_vertex_index].out_edges[edge_location.out_edge_index].data;
+  }
 };
+using Graph = BasicGraph<N_DELIVERIES>;
 
 constexpr size_t ROOT_MARKER = 0;
 struct LabelHistory {
@@ -77,12 +133,6 @@ struct LabelHistory {
   EdgeLocation edge_location = {}; // meaningless at root
 };
 
-struct Label {
-  State s = {};
-  bool dominated = true;
-  size_t label_tree_index = -1;
-};
-
 } // namespace perf_rcsp
 
 #endif // GRAPH_H
@@ -0,0 +1,248 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "graph_file.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <spdlog/fmt/fmt.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace perf_rcsp {
+
+// The mapped arrays are used as they are, so the in-memory layout must be the on-disk one.
+static_assert(std::endian::native == std::endian::little);
+static_assert(sizeof(Index) == sizeof(uint64_t));
+static_assert(sizeof(Site) == 2 * sizeof(float) && std::is_trivially_copyable_v<Site>);
+static_assert(sizeof(GraphFileHeader) == graph_file_alignment);
+
+namespace {
+
+template <int Capacity> void check_out_edge_data_layout() {
+  using Data = BasicHotExtensionData<Capacity>;
+  static_assert(sizeof(Data) == 6 * sizeof(int32_t) && std::is_trivially_copyable_v<Data>);
+}
+
+size_t align_up(size_t n) { return (n + graph_file_alignment - 1) / graph_file_alignment * graph_file_alignment; }
+
+// The byte offsets of the sections and the file size.
+struct GraphFileLayout {
+  size_t sites = 0;
+  size_t offsets = 0;
+  size_t targets = 0;
+  size_t out_edge_data = 0;
+  size_t extension_indices = 0;
+  size_t size = 0;
+};
+
+template <int Capacity> GraphFileLayout layout_of(size_t vertex_count, size_t edge_count) {
+  GraphFileLayout layout;
+  layout.sites = sizeof(GraphFileHeader);
+  layout.offsets = align_up(layout.sites + vertex_count * sizeof(Site));
+  layout.targets = align_up(layout.offsets + (vertex_count + 1) * sizeof(Index));
+  layout.out_edge_data = align_up(layout.targets + edge_count * sizeof(Index));
+  layout.extension_indices = align_up(layout.out_edge_data + edge_count * sizeof(BasicHotExtensionData<Capacity>));
+  layout.size = align_up(layout.extension_indices + edge_count * sizeof(Index));
+  return layout;
+}
+
+template <typename T> std::span<const T> section(const void *file, size_t offset, size_t count) {
+  return {reinterpret_cast<const T *>(static_cast<const char *>(file) + offset), count};
+}
+
+// The checksum of the header, with the checksum field taken as zero, and of the sections after it.
+uint64_t file_checksum(const void *file, size_t size) {
+  GraphFileHeader header;
+  std::memcpy(&header, file, sizeof(header));
+  header.checksum = 0;
+  std::array<uint64_t, sizeof(GraphFileHeader) / sizeof(uint64_t)> header_words;
+  std::memcpy(header_words.data(), &header, sizeof(header));
+  const auto section_words =
+    section<uint64_t>(file, sizeof(GraphFileHeader), (size - sizeof(GraphFileHeader)) / sizeof(uint64_t));
+  return graph_file_checksum(section_words, graph_file_checksum(header_words));
+}
+
+} // namespace
+
+uint64_t graph_file_checksum(std::span<const uint64_t> words, uint64_t hash) {
+  for (const uint64_t word : words) {
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+template <int Capacity>
+void write_graph_file(
+  const std::filesystem::path &path,
+  const BasicGraph<Capacity> &g,
+  Index source_vertex_index,
+  Index target_vertex_index
+) {
+  check_out_edge_data_layout<Capacity>();
+  const auto &vertices = g.get_vertices();
+  ASSERT_ALWAYS(source_vertex_index < vertices.size() && target_vertex_index < vertices.size());
+  const BasicCsrGraph<Capacity> csr_graph(g);
+  const auto layout = layout_of<Capacity>(csr_graph.vertex_count(), csr_graph.edge_count());
+
+  // Build the file in memory, zero padded, so that the checksum can be computed before it is written.
+  std::vector<uint64_t> words(layout.size / sizeof(uint64_t), 0);
+  auto *file = reinterpret_cast<char *>(words.data());
+  auto copy_section = [file](size_t offset, const auto &values) {
+    std::memcpy(file + offset, values.data(), values.size_bytes());
+  };
+  for (size_t v = 0; v < vertices.size(); ++v) {
+    std::memcpy(file + layout.sites + v * sizeof(Site), &vertices[v].site, sizeof(Site));
+  }
+  copy_section(layout.offsets, csr_graph.all_offsets());
+  copy_section(layout.targets, csr_graph.all_targets());
+  copy_section(layout.out_edge_data, csr_graph.all_out_edge_data());
+  copy_section(layout.extension_indices, csr_graph.all_extension_indices());
+
+  GraphFileHeader header;
+  header.magic = graph_file_magic;
+  header.version = graph_file_version;
+  header.capacity = Capacity;
+  header.vertex_count = csr_graph.vertex_count();
+  header.edge_count = csr_graph.edge_count();
+  header.source_vertex_index = source_vertex_index;
+  header.target_vertex_index = target_vertex_index;
+  std::memcpy(file, &header, sizeof(header));
+  header.checksum = file_checksum(file, layout.size);
+  std::memcpy(file, &header, sizeof(header));
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(file, static_cast<std::streamsize>(layout.size));
+  out.close();
+  if (!out) {
+    throw std::runtime_error(fmt::format("could not write the graph file {}", path.string()));
+  }
+}
+
+template <int Capacity>
+BasicGraphFile<Capacity>::BasicGraphFile(const std::filesystem::path &path, bool verify_checksum) {
+  check_out_edge_data_layout<Capacity>();
+  auto fail = [&path](std::string_view reason) {
+    return std::runtime_error(fmt::format("could not open the graph file {}: {}", path.string(), reason));
+  };
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw fail(std::strerror(errno));
+  }
+  struct stat file_status = {};
+  if (::fstat(fd, &file_status) != 0 || file_status.st_size < static_cast<off_t>(sizeof(GraphFileHeader))) {
+    ::close(fd);
+    throw fail("too small");
+  }
+  mapping_size = static_cast<size_t>(file_status.st_size);
+  mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file open
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    throw fail(std::strerror(errno));
+  }
+
+  auto fail_and_unmap = [&](std::string_view reason) {
+    ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+    return fail(reason);
+  };
+  header = static_cast<const GraphFileHeader *>(mapping);
+  if (header->magic != graph_file_magic) {
+    throw fail_and_unmap("not a graph file");
+  }
+  if (header->version != graph_file_version) {
+    throw fail_and_unmap(fmt::format("unsupported version {}", header->version));
+  }
+  if (header->capacity != static_cast<uint32_t>(Capacity)) {
+    throw fail_and_unmap(fmt::format("the capacity is {} instead of {}", header->capacity, Capacity));
+  }
+  // Each vertex and edge takes at least 8 bytes, which bounds the counts before the layout is computed.
+  const size_t vertex_count = header->vertex_count;
+  const size_t edge_count = header->edge_count;
+  if (vertex_count > mapping_size / sizeof(uint64_t) || edge_count > mapping_size / sizeof(uint64_t) ||
+      layout_of<Capacity>(vertex_count, edge_count).size != mapping_size) {
+    throw fail_and_unmap("the size does not match the header");
+  }
+  if (header->source_vertex_index >= vertex_count || header->target_vertex_index >= vertex_count) {
+    throw fail_and_unmap("the source or target vertex is out of range");
+  }
+
+  const auto layout = layout_of<Capacity>(vertex_count, edge_count);
+  const auto offsets = section<Index>(mapping, layout.offsets, vertex_count + 1);
+  const auto targets = section<Index>(mapping, layout.targets, edge_count);
+  const auto out_edge_data = section<BasicHotExtensionData<Capacity>>(mapping, layout.out_edge_data, edge_count);
+  if (verify_checksum) {
+    if (file_checksum(mapping, mapping_size) != header->checksum) {
+      throw fail_and_unmap("the checksum does not match");
+    }
+    auto is_valid_delivery_index = [](const BasicHotExtensionData<Capacity> &data) {
+      return (data.delivery_index >= 0 && data.delivery_index < Capacity) ||
+             data.delivery_index == not_a_delivery_marker<Capacity>;
+    };
+    if (offsets.front() != 0 || offsets.back() != edge_count || !std::ranges::is_sorted(offsets) ||
+        !std::ranges::all_of(targets, [vertex_count](Index w) { return w < vertex_count; }) ||
+        !std::ranges::all_of(out_edge_data, is_valid_delivery_index)) {
+      throw fail_and_unmap("the edges are not valid");
+    }
+  }
+  site_array = section<Site>(mapping, layout.sites, vertex_count);
+  graph = BasicCsrGraph<Capacity>::view(
+    offsets, targets, out_edge_data, section<Index>(mapping, layout.extension_indices, edge_count)
+  );
+}
+
+template <int Capacity> BasicGraphFile<Capacity>::~BasicGraphFile() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, mapping_size);
+  }
+}
+
+template <int Capacity> BasicGraph<Capacity> BasicGraphFile<Capacity>::to_graph() const {
+  BasicGraph<Capacity> g;
+  for (const Site &site : site_array) {
+    g.add_vertex(site);
+  }
+  for (Index v = 0; v < graph.vertex_count(); ++v) {
+    const auto targets = graph.out_edge_targets(v);
+    const auto data = graph.out_edge_data(v);
+    for (Index out_edge_index = 0; out_edge_index < targets.size(); ++out_edge_index) {
+      const auto &hot = data[out_edge_index];
+      g.add_edge(
+        v, targets[out_edge_index],
+        BasicExtensionData<Capacity>{
+          graph.extension_index(EdgeLocation{v, out_edge_index}), hot.earliest_time, hot.latest_time, hot.cost_change,
+          hot.time_change, hot.energy_change, hot.delivery_index
+        }
+      );
+    }
+  }
+  return g;
+}
+
+#define INSTANTIATE_GRAPH_FILE(CAPACITY)                                                                               \
+  template void write_graph_file(const std::filesystem::path &, const BasicGraph<CAPACITY> &, Index, Index);          \
+  template class BasicGraphFile<CAPACITY>;
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_GRAPH_FILE)
+
+} // namespace perf_rcsp
@@ -0,0 +1,104 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include "csr_graph.h"
+#include "graph.h"
+#include "vrp_model.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace perf_rcsp {
+
+// A graph file stores an instance, i.e. a graph and its source and target vertices, in a little-endian binary format
+// that is laid out as the arrays of a BasicCsrGraph, so that a mapped file can be searched without parsing or copying.
+// The file starts with a GraphFileHeader, followed by these sections, each starting at a multiple of
+// graph_file_alignment bytes and padded with zeros:
+//   sites              vertex_count Site
+//   offsets            vertex_count + 1 uint64, see BasicCsrGraph
+//   targets            edge_count uint64
+//   out edge data      edge_count BasicHotExtensionData<capacity>, i.e. 6 int32 each
+//   extension indices  edge_count uint64, the BasicExtensionData::index of each edge
+struct GraphFileHeader {
+  std::array<char, 8> magic = {};
+  uint32_t version = 0;
+  uint32_t capacity = 0; // the delivery capacity of the graph
+  uint64_t vertex_count = 0;
+  uint64_t edge_count = 0;
+  uint64_t source_vertex_index = 0;
+  uint64_t target_vertex_index = 0;
+  uint64_t checksum = 0; // of the file with this field taken as zero, see graph_file_checksum
+  uint64_t reserved = 0;
+};
+
+constexpr std::array<char, 8> graph_file_magic = {'P', 'R', 'C', 'S', 'P', 'G', 'F', '\0'};
+constexpr uint32_t graph_file_version = 2;
+constexpr size_t graph_file_alignment = 64;
+
+// The checksum of a graph file: FNV-1a over 64-bit little-endian words instead of bytes, which is several times
+// faster on large files. It covers the header, with the checksum field taken as zero, and the sections, which are
+// padded to whole words. hash is the checksum of the words before words, so that the file can be hashed in parts.
+constexpr uint64_t graph_file_checksum_basis = 14695981039346656037ULL;
+uint64_t graph_file_checksum(std::span<const uint64_t> words, uint64_t hash = graph_file_checksum_basis);
+
+// Writes g with its source and target vertices to path. The edges are stored vertex by vertex, so the edge indices of
+// BasicGraph::add_edge are renumbered in that order when the file is read back with to_graph, but the
+// BasicExtensionData::index of each edge is kept. Throws std::runtime_error if the file can not be written.
+template <int Capacity>
+void write_graph_file(
+  const std::filesystem::path &path,
+  const BasicGraph<Capacity> &g,
+  Index source_vertex_index,
+  Index target_vertex_index
+);
+
+// BasicGraphFile maps a graph file read-only into memory. csr_graph is a view of the mapped arrays, so opening a file
+// only reads the header and, with verify_checksum, the whole file for the checksum and a check that the edges are
+// valid.
+// The pages are loaded on first use and shared with other processes that map the same file. Without verify_checksum,
+// the sections are trusted. The constructor throws std::runtime_error if the file can not be mapped or is not a valid
+// graph file of this capacity.
+template <int Capacity> class BasicGraphFile {
+  void *mapping = nullptr;
+  size_t mapping_size = 0;
+  const GraphFileHeader *header = nullptr;
+  std::span<const Site> site_array;
+  BasicCsrGraph<Capacity> graph;
+
+public:
+  explicit BasicGraphFile(const std::filesystem::path &path, bool verify_checksum = true);
+  ~BasicGraphFile();
+  BasicGraphFile(const BasicGraphFile &) = delete;
+  BasicGraphFile &operator=(const BasicGraphFile &) = delete;
+
+  // The view of the mapped arrays, valid while this is alive.
+  [[nodiscard]] const BasicCsrGraph<Capacity> &csr_graph() const { return graph; }
+  [[nodiscard]] std::span<const Site> sites() const { return site_array; }
+  [[nodiscard]] Index source_vertex_index() const { return header->source_vertex_index; }
+  [[nodiscard]] Index target_vertex_index() const { return header->target_vertex_index; }
+
+  // Returns a copy of the graph as a BasicGraph, e.g. to convert it to a BoostGraph.
+  [[nodiscard]] BasicGraph<Capacity> to_graph() const;
+};
+using GraphFile = BasicGraphFile<N_DELIVERIES>;
+
+} // namespace perf_rcsp
+
+#endif // GRAPH_FILE_H
@@ -0,0 +1,537 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef LABEL_BUCKET_H
+#define LABEL_BUCKET_H
+
+#include "vrp_model.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace perf_rcsp {
+
+// BasicLabelBucket stores the labels of one vertex as a structure of arrays, i.e. one contiguous array per resource,
+// so that the dominance checks of a new candidate State against all labels of the vertex can be done for several
+// labels per instruction. The SIMD kernels are used for the 32 delivery capacity where the delivered masks fit in the
+// same 32-bit lanes as the other resources, larger capacities use the scalar loop. The times and energies are stored as
+// LabelTime and LabelEnergy, see compact_labels, and widened to 32-bit lanes when loaded.
+template <int Capacity> class BasicLabelBucket {
+  using DeliverySetType = BasicDeliverySet<Capacity>;
+  static constexpr bool has_simd_kernels = sizeof(DeliverySetType) == sizeof(int);
+  // With compact_labels, 32-bit label tree indices, so that a label takes 16 bytes with the 32 delivery capacity.
+  using LabelTreeIndex = std::conditional_t<compact_labels, uint32_t, size_t>;
+  // The dominated flag of a label is the top bit of its label tree index.
+  static constexpr LabelTreeIndex dominated_bit = LabelTreeIndex{1} << (sizeof(LabelTreeIndex) * 8 - 1);
+
+  std::vector<int> costs;
+  std::vector<LabelTime> times;
+  std::vector<LabelEnergy> energies;
+  std::vector<DeliverySetType> delivered_masks;
+  std::vector<LabelTreeIndex> label_tree_indices; // with the dominated flags, see dominated_bit
+  std::vector<uint32_t> order; // scratch for compact_and_sort_by_time
+  // After compact_and_bucket_by_time, the labels [0, bucketed_size) are grouped by time bucket: the labels of bucket b
+  // are [bucket_begins[b], bucket_begins[b + 1]) and have a time in [time_origin + b * bucket_width, time_origin +
+  // (b + 1) * bucket_width). The labels pushed after it are not grouped.
+  std::vector<uint32_t> bucket_begins;
+  size_t bucketed_size = 0;
+  int time_origin = 0;
+  int bucket_width = 1;
+  // After compact_and_sort_by_time or compact_with_pareto_sweep, the labels [0, sorted_size) are sorted by time.
+  size_t sorted_size = 0;
+  // After settle, the labels [0, settled_size) are being extended and are only checked as possible dominators.
+  size_t settled_size = 0;
+
+  // The directions of the dominance checks of a range of labels, see is_dominated_or_mark_dominated.
+  enum class Checks { label_dominates, both, candidate_dominates };
+
+public:
+  [[nodiscard]] size_t size() const { return costs.size(); }
+  [[nodiscard]] bool empty() const { return costs.empty(); }
+
+  void reserve(size_t n) {
+    costs.reserve(n);
+    times.reserve(n);
+    energies.reserve(n);
+    delivered_masks.reserve(n);
+    label_tree_indices.reserve(n);
+  }
+
+  void clear() {
+    costs.clear();
+    times.clear();
+    energies.clear();
+    delivered_masks.clear();
+    label_tree_indices.clear();
+    bucketed_size = 0;
+    sorted_size = 0;
+    settled_size = 0;
+  }
+
+  void push_back(const BasicState<Capacity> &s, size_t label_tree_index) {
+    ASSERT_ALWAYS(label_tree_index < dominated_bit);
+    if constexpr (compact_labels) {
+      ASSERT_ALWAYS(fits_in_labels(s));
+    }
+    costs.push_back(s.cost);
+    times.push_back(static_cast<LabelTime>(s.time));
+    energies.push_back(static_cast<LabelEnergy>(s.energy));
+    delivered_masks.push_back(s.delivered);
+    label_tree_indices.push_back(static_cast<LabelTreeIndex>(label_tree_index));
+  }
+
+
+  [[nodiscard]] BasicState<Capacity> state(size_t i) const {
+    return BasicState<Capacity>{costs[i], times[i], energies[i], delivered_masks[i]};
+  }
+  [[nodiscard]] int cost(size_t i) const { return costs[i]; }
+  [[nodiscard]] int time(size_t i) const { return times[i]; }
+  [[nodiscard]] int energy(size_t i) const { return energies[i]; }
+  [[nodiscard]] const DeliverySetType &delivered(size_t i) const { return delivered_masks[i]; }
+  [[nodiscard]] bool dominated(size_t i) const { return (label_tree_indices[i] & dominated_bit) != 0; }
+  [[nodiscard]] size_t label_tree_index(size_t i) const { return label_tree_indices[i] & ~dominated_bit; }
+  [[nodiscard]] size_t dominated_count() const {
+    return static_cast<size_t>(
+      std::ranges::count_if(label_tree_indices, [](LabelTreeIndex index) { return (index & dominated_bit) != 0; })
+    );
+  }
+
+  // Adds offset to the label tree indices of the labels from index first on.
+  void offset_label_tree_indices(size_t first, size_t offset) {
+    for (size_t i = first; i < size(); ++i) {
+      ASSERT_ALWAYS(label_tree_index(i) + offset < dominated_bit);
+      label_tree_indices[i] += static_cast<LabelTreeIndex>(offset);
+    }
+  }
+
+  // Replaces the label tree index of each label with new_label_tree_indices[label tree index].
+  void remap_label_tree_indices(const std::vector<size_t> &new_label_tree_indices) {
+    for (size_t i = 0; i < size(); ++i) {
+      label_tree_indices[i] = (label_tree_indices[i] & dominated_bit) |
+                              static_cast<LabelTreeIndex>(new_label_tree_indices[label_tree_index(i)]);
+    }
+  }
+
+  // Removes the dominated labels and sorts the remaining labels by increasing time.
+  void compact_and_sort_by_time() {
+    order.clear();
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        order.push_back(i);
+      }
+    }
+    std::ranges::sort(order, [this](auto lhs, auto rhs) { return times[lhs] < times[rhs]; });
+    permute_all();
+    bucketed_size = 0;
+    sorted_size = size();
+    settled_size = 0;
+  }
+
+  // Removes the dominated labels and the labels that another label dominates, e.g. after adding labels without
+  // dominance checks. The labels are sorted by time, then cost, then decreasing energy and delivery count, so that a
+  // label can only be dominated by the labels before it, and then swept once: each label is only checked for whether a
+  // kept label before it dominates it, which stops at the first such label. Of equal labels, the oldest one is kept, as
+  // with is_dominated_or_mark_dominated. The remaining labels are sorted by increasing time.
+  void compact_with_pareto_sweep() {
+    order.clear();
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        order.push_back(i);
+      }
+    }
+    auto key = [this](uint32_t i) {
+      return std::tuple(times[i], costs[i], -energies[i], -delivered_masks[i].count(), label_tree_indices[i]);
+    };
+    std::ranges::sort(order, {}, key);
+    permute_all();
+    bucketed_size = 0;
+    settled_size = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      if (check_range<Checks::label_dominates>(state(i), 0, kept)) {
+        continue;
+      }
+      costs[kept] = costs[i];
+      times[kept] = times[i];
+      energies[kept] = energies[i];
+      delivered_masks[kept] = delivered_masks[i];
+      label_tree_indices[kept] = label_tree_indices[i];
+      ++kept;
+    }
+    costs.resize(kept);
+    times.resize(kept);
+    energies.resize(kept);
+    delivered_masks.resize(kept);
+    label_tree_indices.resize(kept);
+    sorted_size = kept;
+  }
+
+  // Removes the dominated labels and groups the remaining labels by time buckets of width bucket_width with a counting
+  // sort, i.e. without comparisons. Until the next push_back, the dominance checks then only check whether a label
+  // dominates the candidate for the labels in earlier buckets than the candidate's time, and the other way around for
+  // the labels in later buckets.
+  void compact_and_bucket_by_time(int width) {
+    ASSERT_ALWAYS(width >= 1);
+    bucket_width = width;
+    int min_time = std::numeric_limits<int>::max();
+    int max_time = std::numeric_limits<int>::min();
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        min_time = std::min<int>(min_time, times[i]);
+        max_time = std::max<int>(max_time, times[i]);
+      }
+    }
+    time_origin = min_time;
+    const size_t bucket_count = min_time <= max_time ? bucket_of(max_time) + 1 : 0;
+    bucket_begins.assign(bucket_count + 1, 0);
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        ++bucket_begins[bucket_of(times[i]) + 1];
+      }
+    }
+    for (size_t b = 0; b < bucket_count; ++b) {
+      bucket_begins[b + 1] += bucket_begins[b];
+    }
+    order.resize(bucket_begins[bucket_count]);
+    // Place each label at the next free position of its bucket, which moves each bucket's begin to its end. Then
+    // shift the begins back.
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        order[bucket_begins[bucket_of(times[i])]++] = i;
+      }
+    }
+    for (size_t b = bucket_count; b > 0; --b) {
+      bucket_begins[b] = bucket_begins[b - 1];
+    }
+    bucket_begins[0] = 0;
+    permute_all();
+    bucketed_size = size();
+    sorted_size = 0;
+    settled_size = 0;
+  }
+
+  // For a search that extends the labels in order of increasing time: removes the dominated labels and the settled
+  // labels, which have been extended, and then settles the labels with the given time, i.e. moves them to the front.
+  // Returns their count. Like the labels of the last round in the ping-pong rounds, the settled labels are kept until
+  // the next call since they may still dominate new labels. Their time is at most that of the new labels, so the
+  // dominance checks only check whether they dominate the candidate.
+  size_t settle(int time) {
+    order.clear();
+    for (uint32_t i = settled_size; i < size(); ++i) {
+      if (!dominated(i) && times[i] == time) {
+        order.push_back(i);
+      }
+    }
+    const size_t settled_count = order.size();
+    for (uint32_t i = settled_size; i < size(); ++i) {
+      if (!dominated(i) && times[i] != time) {
+        order.push_back(i);
+      }
+    }
+    permute_all();
+    bucketed_size = 0;
+    sorted_size = 0;
+    settled_size = settled_count;
+    return settled_count;
+  }
+
+  // Returns the end of the labels that may have a time of at most time, e.g. the latest time at which an edge can be
+  // started: the labels from it on all have a later time, so they can be skipped together. It is exact when all labels
+  // are sorted by time, rounded up to the end of a bucket when they are bucketed by time, and otherwise size().
+  [[nodiscard]] size_t end_of_time(int time) const {
+    if (sorted_size == size()) {
+      return static_cast<size_t>(
+        std::ranges::upper_bound(times, time, {}, [](LabelTime label_time) { return static_cast<int>(label_time); }) -
+        times.begin()
+      );
+    }
+    if (bucketed_size == size()) {
+      if (time < time_origin) {
+        return 0;
+      }
+      const auto b = static_cast<size_t>((static_cast<int64_t>(time) - time_origin) / bucket_width) + 1;
+      return b < bucket_begins.size() ? bucket_begins[b] : size();
+    }
+    return size();
+  }
+
+  // Marks all labels except the n cheapest labels that are not dominated as dominated, so that the next
+  // compact_and_sort_by_time removes them. Ties in cost are broken by time. Used by the heuristic searches.
+  void keep_cheapest(size_t n) {
+    order.clear();
+    for (uint32_t i = 0; i < size(); ++i) {
+      if (!dominated(i)) {
+        order.push_back(i);
+      }
+    }
+    if (order.size() <= n) {
+      return;
+    }
+    const auto nth = order.begin() + static_cast<std::ptrdiff_t>(n);
+    std::ranges::nth_element(order, nth, [this](auto lhs, auto rhs) {
+      return std::tie(costs[lhs], times[lhs]) < std::tie(costs[rhs], times[rhs]);
+    });
+    for (auto it = nth; it != order.end(); ++it) {
+      label_tree_indices[*it] |= dominated_bit;
+    }
+  }
+
+  // Returns true if a label in the bucket dominates candidate. Otherwise, marks the labels that candidate dominates as
+  // dominated and returns false.
+  bool is_dominated_or_mark_dominated(const BasicState<Capacity> &candidate);
+
+  // Returns true if a label in the bucket dominates candidate. Unlike is_dominated_or_mark_dominated, the labels are
+  // not modified, so other threads may read them meanwhile.
+  bool is_dominated(const BasicState<Capacity> &candidate) {
+    return check_range<Checks::label_dominates>(candidate, 0, size());
+  }
+
+private:
+  [[nodiscard]] size_t bucket_of(int time) const { return static_cast<size_t>((time - time_origin) / bucket_width); }
+
+  void permute_all() {
+    permute(costs);
+    permute(times);
+    permute(energies);
+    permute(delivered_masks);
+    permute(label_tree_indices);
+  }
+
+  // Checks the labels [begin, end) in the directions of checks. Returns true if a label dominates candidate.
+  template <Checks checks> bool check_range(const BasicState<Capacity> &candidate, size_t begin, size_t end);
+
+  // Runs the SIMD kernels over the labels in whole blocks starting at i and before end and advances i past the
+  // checked labels.
+  template <Checks checks>
+  bool simd_check_range(const BasicState<Capacity> &candidate, size_t &i, size_t end)
+    requires(has_simd_kernels);
+
+  template <typename T> void permute(std::vector<T> &values) const {
+    // Gather into the tail of values and then move it to the front to avoid a scratch vector per type.
+    const size_t n = values.size();
+    for (auto i : order) {
+      values.push_back(values[i]);
+    }
+    values.erase(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(n));
+  }
+
+  // Scalar dominance check of label i. Written without branches on the resources so that it can also be used to
+  // handle the tail of the SIMD loops.
+  template <Checks checks> [[nodiscard]] bool check_scalar(size_t i, const BasicState<Capacity> &candidate) {
+    const DeliverySetType &mask = delivered_masks[i];
+    if constexpr (checks != Checks::candidate_dominates) {
+      // Same condition as is_dominate(label, candidate)
+      const bool label_dominates = (costs[i] <= candidate.cost) & (times[i] <= candidate.time) &
+                                   (energies[i] >= candidate.energy) & candidate.delivered.is_subset_of(mask);
+      if (label_dominates) {
+        return true;
+      }
+    }
+    if constexpr (checks != Checks::label_dominates) {
+      // Same condition as is_dominate(candidate, label)
+      const bool candidate_dominates = (candidate.cost <= costs[i]) & (candidate.time <= times[i]) &
+                                       (candidate.energy >= energies[i]) & mask.is_subset_of(candidate.delivered);
+      label_tree_indices[i] |= static_cast<LabelTreeIndex>(candidate_dominates) * dominated_bit;
+    }
+    return false;
+  }
+};
+
+template <int Capacity>
+bool BasicLabelBucket<Capacity>::is_dominated_or_mark_dominated(const BasicState<Capacity> &candidate) {
+  // A label can only dominate the candidate if its time is at most the candidate's and can only be dominated by it if
+  // its time is at least the candidate's, so only the labels in the candidate's time bucket, and those that are not
+  // bucketed, are checked in both directions.
+  if (settled_size > 0) {
+    return check_range<Checks::label_dominates>(candidate, 0, settled_size) ||
+           check_range<Checks::both>(candidate, settled_size, size());
+  }
+  size_t bucket_begin = 0;
+  size_t bucket_end = 0;
+  if (bucketed_size > 0 && candidate.time >= time_origin) {
+    const size_t b = bucket_of(candidate.time);
+    bucket_begin = b + 1 < bucket_begins.size() ? bucket_begins[b] : bucketed_size;
+    bucket_end = b + 1 < bucket_begins.size() ? bucket_begins[b + 1] : bucketed_size;
+  }
+  return check_range<Checks::label_dominates>(candidate, 0, bucket_begin) ||
+         check_range<Checks::both>(candidate, bucket_begin, bucket_end) ||
+         check_range<Checks::both>(candidate, bucketed_size, size()) ||
+         check_range<Checks::candidate_dominates>(candidate, bucket_end, bucketed_size);
+}
+
+template <int Capacity>
+template <typename BasicLabelBucket<Capacity>::Checks checks>
+bool BasicLabelBucket<Capacity>::check_range(const BasicState<Capacity> &candidate, size_t begin, size_t end) {
+  size_t i = begin;
+  if constexpr (has_simd_kernels) {
+    if (simd_check_range<checks>(candidate, i, end)) {
+      return true;
+    }
+  }
+  // Scalar fallback, also handles the tail of the SIMD loops.
+  for (; i < end; ++i) {
+    if (check_scalar<checks>(i, candidate)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <int Capacity>
+template <typename BasicLabelBucket<Capacity>::Checks checks>
+bool BasicLabelBucket<Capacity>::simd_check_range(const BasicState<Capacity> &candidate, size_t &i, size_t n)
+  requires(has_simd_kernels)
+{
+  constexpr bool check_label_dominates = checks != Checks::candidate_dominates;
+  constexpr bool check_candidate_dominates = checks != Checks::label_dominates;
+  const auto candidate_mask = candidate.delivered.to_mask();
+#if defined(__AVX512F__)
+  const __m512i c_cost = _mm512_set1_epi32(candidate.cost);
+  const __m512i c_time = _mm512_set1_epi32(candidate.time);
+  const __m512i c_energy = _mm512_set1_epi32(candidate.energy);
+  const __m512i c_mask = _mm512_set1_epi32(static_cast<int>(candidate_mask));
+  auto load = []<typename T>(const T *values) {
+    if constexpr (sizeof(T) == sizeof(int16_t)) {
+      return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values)));
+    } else {
+      return _mm512_loadu_si512(values);
+    }
+  };
+  for (; i + 16 <= n; i += 16) {
+    const __m512i cost = _mm512_loadu_si512(costs.data() + i);
+    const __m512i time = load(times.data() + i);
+    const __m512i energy = load(energies.data() + i);
+    const __m512i mask = _mm512_loadu_si512(delivered_masks.data() + i);
+    if constexpr (check_label_dominates) {
+      const __m512i candidate_extra = _mm512_andnot_si512(mask, c_mask); // delivered by candidate but not label
+      const __mmask16 label_dominates = _mm512_cmple_epi32_mask(cost, c_cost) &
+                                        _mm512_cmple_epi32_mask(time, c_time) &
+                                        _mm512_cmpge_epi32_mask(energy, c_energy) &
+                                        _mm512_testn_epi32_mask(candidate_extra, candidate_extra);
+      if (label_dominates != 0) {
+        return true;
+      }
+    }
+    if constexpr (check_candidate_dominates) {
+      const __m512i label_extra = _mm512_andnot_si512(c_mask, mask); // delivered by label but not candidate
+      const __mmask16 candidate_dominates = _mm512_cmpge_epi32_mask(cost, c_cost) &
+                                            _mm512_cmpge_epi32_mask(time, c_time) &
+                                            _mm512_cmple_epi32_mask(energy, c_energy) &
+                                            _mm512_testn_epi32_mask(label_extra, label_extra);
+      for (unsigned bits = candidate_dominates; bits != 0; bits &= bits - 1) {
+        label_tree_indices[i + std::countr_zero(bits)] |= dominated_bit;
+      }
+    }
+  }
+#elif defined(__AVX2__)
+  const __m256i c_cost = _mm256_set1_epi32(candidate.cost);
+  const __m256i c_time = _mm256_set1_epi32(candidate.time);
+  const __m256i c_energy = _mm256_set1_epi32(candidate.energy);
+  const __m256i c_mask = _mm256_set1_epi32(static_cast<int>(candidate_mask));
+  const __m256i zero = _mm256_setzero_si256();
+  auto lanes = [](__m256i v) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v))); };
+  auto load = []<typename T>(const T *values) {
+    if constexpr (sizeof(T) == sizeof(int16_t)) {
+      return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values)));
+    } else {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    }
+  };
+  for (; i + 8 <= n; i += 8) {
+    const __m256i cost = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(costs.data() + i));
+    const __m256i time = load(times.data() + i);
+    const __m256i energy = load(energies.data() + i);
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(delivered_masks.data() + i));
+    // AVX2 only has a signed greater than compare, so collect the lanes that fail the other conditions.
+    if constexpr (check_label_dominates) {
+      const __m256i candidate_subset = _mm256_cmpeq_epi32(_mm256_andnot_si256(mask, c_mask), zero);
+      const __m256i label_fails = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi32(cost, c_cost), _mm256_cmpgt_epi32(time, c_time)),
+        _mm256_cmpgt_epi32(c_energy, energy)
+      );
+      if (lanes(_mm256_andnot_si256(label_fails, candidate_subset)) != 0) {
+        return true;
+      }
+    }
+    if constexpr (check_candidate_dominates) {
+      const __m256i label_subset = _mm256_cmpeq_epi32(_mm256_andnot_si256(c_mask, mask), zero);
+      const __m256i candidate_fails = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi32(c_cost, cost), _mm256_cmpgt_epi32(c_time, time)),
+        _mm256_cmpgt_epi32(energy, c_energy)
+      );
+      for (unsigned bits = lanes(_mm256_andnot_si256(candidate_fails, label_subset)); bits != 0; bits &= bits - 1) {
+        label_tree_indices[i + std::countr_zero(bits)] |= dominated_bit;
+      }
+    }
+  }
+#elif defined(__SSE2__)
+  // x86-64 always has SSE2 and the Release build's -mavx (no AVX2) gives VEX encoded 128-bit integer compares.
+  const __m128i c_cost = _mm_set1_epi32(candidate.cost);
+  const __m128i c_time = _mm_set1_epi32(candidate.time);
+  const __m128i c_energy = _mm_set1_epi32(candidate.energy);
+  const __m128i c_mask = _mm_set1_epi32(static_cast<int>(candidate_mask));
+  const __m128i zero = _mm_setzero_si128();
+  auto lanes = [](__m128i v) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v))); };
+  auto load = []<typename T>(const T *values) {
+    if constexpr (sizeof(T) == sizeof(int16_t)) {
+      // Sign extend with SSE2 only: duplicate each 16-bit value into a 32-bit lane and shift it down.
+      const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(values));
+      return _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+    } else {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i *>(values));
+    }
+  };
+  for (; i + 4 <= n; i += 4) {
+    const __m128i cost = _mm_loadu_si128(reinterpret_cast<const __m128i *>(costs.data() + i));
+    const __m128i time = load(times.data() + i);
+    const __m128i energy = load(energies.data() + i);
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(delivered_masks.data() + i));
+    if constexpr (check_label_dominates) {
+      const __m128i candidate_subset = _mm_cmpeq_epi32(_mm_andnot_si128(mask, c_mask), zero);
+      const __m128i label_fails = _mm_or_si128(
+        _mm_or_si128(_mm_cmpgt_epi32(cost, c_cost), _mm_cmpgt_epi32(time, c_time)), _mm_cmplt_epi32(energy, c_energy)
+      );
+      if (lanes(_mm_andnot_si128(label_fails, candidate_subset)) != 0) {
+        return true;
+      }
+    }
+    if constexpr (check_candidate_dominates) {
+      const __m128i label_subset = _mm_cmpeq_epi32(_mm_andnot_si128(c_mask, mask), zero);
+      const __m128i candidate_fails = _mm_or_si128(
+        _mm_or_si128(_mm_cmplt_epi32(cost, c_cost), _mm_cmplt_epi32(time, c_time)), _mm_cmpgt_epi32(energy, c_energy)
+      );
+      for (unsigned bits = lanes(_mm_andnot_si128(candidate_fails, label_subset)); bits != 0; bits &= bits - 1) {
+        label_tree_indices[i + std::countr_zero(bits)] |= dominated_bit;
+      }
+    }
+  }
+#endif
+  return false;
+}
+
+using LabelBucket = BasicLabelBucket<N_DELIVERIES>;
+
+} // namespace perf_rcsp
+
+#endif // LABEL_BUCKET_H
@@ -18,157 +18,1023 @@
 
 #include "rcsp.h"
 
+#include "label_bucket.h"
+
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
 #include <ranges>
+#include <spdlog/spdlog.h>
+#include <tuple>
 #include <vector>
 
 namespace perf_rcsp {
 
 namespace views = std::views;
 
-// extend_and_handle_domination extends state to create a new state and handles domination:
+// Pruning holds the completion bounds, if any, that new labels must pass.
+struct Pruning {
+  const CompletionBounds *bounds = nullptr;
+  int cost_upper_bound = std::numeric_limits<int>::max();
+
+  template <int Capacity> [[nodiscard]] bool drops(const BasicState<Capacity> &state, Index vertex_index) const {
+    return bounds != nullptr && !bounds->may_complete(state, vertex_index, cost_upper_bound);
+  }
+
+  // Returns the latest time at which a label can start the edge of data into vertex_index: its latest_time or, with
+  // the bounds, earlier if the label would arrive after the latest departure time of vertex_index and be dropped.
+  template <int Capacity>
+  [[nodiscard]] int latest_start(const BasicHotExtensionData<Capacity> &data, Index vertex_index) const {
+    if (bounds == nullptr) {
+      return data.latest_time;
+    }
+    // A label that starts at time t arrives at max(t, earliest_time) + time_change.
+    const int64_t latest_arrival_time = bounds->latest_departure_times[vertex_index];
+    if (static_cast<int64_t>(data.earliest_time) + data.time_change > latest_arrival_time) {
+      return std::numeric_limits<int>::min();
+    }
+    return static_cast<int>(std::min<int64_t>(data.latest_time, latest_arrival_time - data.time_change));
+  }
+};
+
+// Adds n to counter with search_stats, and otherwise does nothing.
+void count_stat(size_t &counter, size_t n = 1) {
+  if constexpr (search_stats) {
+    counter += n;
+  }
+}
+
+// Calls f and, with search_stats, adds the time it took to duration.
+template <typename F> void timed(std::chrono::nanoseconds &duration, F &&f) {
+  if constexpr (search_stats) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    duration += std::chrono::steady_clock::now() - start;
+  } else {
+    f();
+  }
+}
+
+template <int Capacity> void clear_solutions(BasicSolutions<Capacity> &solutions, Arena &arena) {
+  // The previous solutions live in the arena, so drop them before the arena is reset. Both sides use the arena, so
+  // the move assignments do not copy.
+  solutions.nondominated_paths = std::pmr::vector<std::pmr::vector<EdgeLocation>>(&arena);
+  solutions.nondominated_end_states = std::pmr::vector<BasicState<Capacity>>(&arena);
+  arena.reset();
+}
+
+// Adds the nondominated labels at the target and their paths to solutions.
+template <int Capacity>
+void collect_solutions(
+  const BasicLabelBucket<Capacity> &target_labels,
+  const std::vector<LabelHistory> &label_tree,
+  BasicSolutions<Capacity> &solutions
+) {
+  for (size_t i = 0; i < target_labels.size(); ++i) {
+    if (target_labels.dominated(i)) {
+      continue;
+    }
+    auto &path = solutions.nondominated_paths.emplace_back();
+    Index label_tree_index = target_labels.label_tree_index(i);
+    while (label_tree_index != ROOT_MARKER) {
+      const auto &lh = label_tree[label_tree_index];
+      path.push_back(lh.edge_location);
+      label_tree_index = lh.parent_label_tree_index;
+    }
+    solutions.nondominated_end_states.push_back(target_labels.state(i));
+  }
+}
+
+// Returns the number of nondominated labels at the target below the cost upper bound.
+template <int Capacity>
+size_t count_solutions(const BasicLabelBucket<Capacity> &target_labels, const Pruning &pruning) {
+  size_t count = 0;
+  for (size_t i = 0; i < target_labels.size(); ++i) {
+    count += static_cast<size_t>(!target_labels.dominated(i) && target_labels.cost(i) < pruning.cost_upper_bound);
+  }
+  return count;
+}
+
+// extend_and_handle_domination extends the label label_index of labels to create a new state and handles domination:
 // do not add a new state if it is dominated and marking other states as dominated if the
-// new state dominates them.
+// new state dominates them. The feasibility is checked on the label's resources before the new state is built, and
+// the new state is checked for dominance before it is stored. With lazy_dominance, the new state is only checked
+// against the current labels and the dominance among the next labels is resolved in one batch, see
+// BasicLabelBucket::compact_with_pareto_sweep. In a concurrent round, other threads read the current labels, so they
+// are only checked and not marked.
+template <int Capacity>
 void extend_and_handle_domination(
-  const Label &old_label,
-  const ExtensionData &extension_data,
-  std::vector<Label> &next_labels, // next labels at target vertex
-  std::vector<Label> &curr_labels, // current labels at target vertex
+  const BasicLabelBucket<Capacity> &labels,
+  size_t label_index,
+  const BasicHotExtensionData<Capacity> &extension_data,
+  const Pruning &pruning,
+  Index target_vertex_index,
+  BasicLabelBucket<Capacity> &next_labels, // next labels at target vertex
+  BasicLabelBucket<Capacity> &curr_labels, // current labels at target vertex
   Index node_index,
   Index out_edge_index,
-  std::vector<LabelHistory> &label_tree
+  std::vector<LabelHistory> &label_tree,
+  bool lazy_dominance,
+  bool concurrent_round,
+  ExtensionStats &stats
 ) {
+  count_stat(stats.attempted);
 
-  // TODO: consider inlining extend and avoid creating new_state until it is
-  //  more certain that it would be valid.
-  State new_state;
-  if (!extend(old_label.s, extension_data, new_state)) {
+  const int time = labels.time(label_index);
+  const int energy = labels.energy(label_index);
+  const auto &delivered = labels.delivered(label_index);
+  if (!can_extend(time, energy, delivered, extension_data)) {
+    count_stat(stats.infeasible);
     return;
   }
+  // The candidate is built from the label's columns with the extension applied, and is only stored if it is neither
+  // dropped nor dominated.
+  const BasicState<Capacity> new_state =
+    extend_feasible(labels.cost(label_index), time, energy, delivered, extension_data);
 
-  for (auto &l : curr_labels) {
-    if (is_dominate(l.s, new_state)) {
+  if (pruning.drops(new_state, target_vertex_index)) {
+    count_stat(stats.pruned);
+    return;
+  }
+
+  count_stat(stats.dominance_checks, curr_labels.size());
+  if (concurrent_round ? curr_labels.is_dominated(new_state) : curr_labels.is_dominated_or_mark_dominated(new_state)) {
+    count_stat(stats.dominated);
+    return;
+  }
+
+  if (!lazy_dominance) {
+    count_stat(stats.dominance_checks, next_labels.size());
+    if (next_labels.is_dominated_or_mark_dominated(new_state)) {
+      count_stat(stats.dominated);
       return;
     }
-    if (is_dominate(new_state, l.s)) {
-      l.dominated = true;
+  }
+
+  size_t tree_index = label_tree.size();
+  label_tree.emplace_back(labels.label_tree_index(label_index), tree_index, EdgeLocation{node_index, out_edge_index});
+  next_labels.push_back(new_state, tree_index);
+}
+
+// Removes the entries of the label tree that no label in curr or next descends from, i.e. the branches of the labels
+// that were dominated or extended, by mark-compact: the ancestors of the labels are marked and the marked entries are
+// moved to the front in order. A parent is created before its children, so it still comes before them, and the
+// indices of the labels are mapped to the new ones.
+template <int Capacity>
+void compact_label_tree(
+  std::vector<LabelHistory> &label_tree,
+  std::vector<BasicLabelBucket<Capacity>> &curr,
+  std::vector<BasicLabelBucket<Capacity>> &next,
+  std::vector<size_t> &new_label_tree_indices
+) {
+  constexpr size_t unmarked = std::numeric_limits<size_t>::max();
+  new_label_tree_indices.assign(label_tree.size(), unmarked);
+  new_label_tree_indices[ROOT_MARKER] = ROOT_MARKER;
+  auto mark_ancestors = [&](const auto &buckets) {
+    for (const auto &labels : buckets) {
+      for (size_t i = 0; i < labels.size(); ++i) {
+        // Stops at the first marked ancestor since its ancestors are already marked.
+        for (size_t index = labels.label_tree_index(i); new_label_tree_indices[index] == unmarked;
+             index = label_tree[index].parent_label_tree_index) {
+          new_label_tree_indices[index] = ROOT_MARKER;
+        }
+      }
+    }
+  };
+  mark_ancestors(curr);
+  mark_ancestors(next);
+
+  size_t kept = 1; // the root
+  for (size_t index = 1; index < label_tree.size(); ++index) {
+    if (new_label_tree_indices[index] == unmarked) {
+      continue;
     }
+    new_label_tree_indices[index] = kept;
+    LabelHistory lh = label_tree[index];
+    lh.parent_label_tree_index = new_label_tree_indices[lh.parent_label_tree_index];
+    lh.label_tree_index = kept;
+    label_tree[kept++] = lh;
+  }
+  label_tree.resize(kept);
+  for (auto &labels : curr) {
+    labels.remap_label_tree_indices(new_label_tree_indices);
+  }
+  for (auto &labels : next) {
+    labels.remap_label_tree_indices(new_label_tree_indices);
   }
+}
 
-  for (auto &l : next_labels) {
-    if (is_dominate(l.s, new_state)) {
+// Returns the end of the labels of vertex_labels to extend along the edge of data into w: the labels from it on have a
+// time after Pruning::latest_start, so their extensions are infeasible or dropped and they are skipped together, which
+// saves most of the extensions of the dense graphs in which most edges can only be used early. With search_stats, the
+// skipped labels are counted as extend_and_handle_domination would have, except the dominated ones if skip_dominated.
+template <int Capacity>
+size_t extended_labels_end(
+  const BasicLabelBucket<Capacity> &vertex_labels,
+  const BasicHotExtensionData<Capacity> &data,
+  Index w,
+  const Pruning &pruning,
+  bool skip_dominated,
+  ExtensionStats &stats
+) {
+  const size_t end = vertex_labels.end_of_time(pruning.latest_start(data, w));
+  if constexpr (search_stats) {
+    for (size_t i = end; i < vertex_labels.size(); ++i) {
+      if (skip_dominated && vertex_labels.dominated(i)) {
+        continue;
+      }
+      ++stats.attempted;
+      if (can_extend(vertex_labels.time(i), vertex_labels.energy(i), vertex_labels.delivered(i), data)) {
+        ++stats.pruned;
+      } else {
+        ++stats.infeasible;
+      }
+    }
+  }
+  return end;
+}
+
+// Extends the labels in curr of each vertex, in the order of vertex_indices, into next.
+template <int Capacity>
+void extend_round_serial(
+  const BasicCsrGraph<Capacity> &g,
+  const Pruning &pruning,
+  const std::vector<size_t> &vertex_indices,
+  std::vector<BasicLabelBucket<Capacity>> &curr,
+  std::vector<BasicLabelBucket<Capacity>> &next,
+  std::vector<LabelHistory> &label_tree,
+  bool lazy_dominance,
+  ExtensionStats &stats
+) {
+  for (auto vertex_index : vertex_indices) {
+    auto &vertex_labels = curr[vertex_index];
+    if (vertex_labels.empty()) {
+      continue;
+    }
+    const auto targets = g.out_edge_targets(vertex_index);
+    const auto data = g.out_edge_data(vertex_index);
+    // The idea behind looping edge and then states is for more performant memory access
+    // patterns: write all states to one target vertex before switching to another target vertex
+    for (size_t out_edge_index = 0; out_edge_index != targets.size(); ++out_edge_index) {
+      const Index w = targets[out_edge_index];
+      const size_t end = extended_labels_end(vertex_labels, data[out_edge_index], w, pruning, true, stats);
+      next[w].reserve(next[w].size() + end);
+      for (size_t i = 0; i < end; ++i) {
+        if (vertex_labels.dominated(i)) {
+          continue;
+        }
+        extend_and_handle_domination(
+          vertex_labels, i, data[out_edge_index], pruning, w, next[w], curr[w], vertex_index, out_edge_index,
+          label_tree, lazy_dominance, false, stats
+        );
+      }
+    }
+    vertex_labels.clear();
+  }
+}
+
+// Same as extend_round_serial but in parallel: the target vertices are split into contiguous blocks and each task
+// extends all labels along the edges into one block. A task only writes the buckets of its own block and its own
+// label tree segment, so the tasks do not need any synchronization. The segments are then merged in block order.
+//
+// Unlike the serial round, labels that become dominated during the round are still extended and the labels in curr
+// are compared with until the end of the round, so the tasks do not mark the labels in curr, which the other tasks
+// read. Each target's labels only depend on the labels at the start of the round, so the result is the same for any
+// number of threads and the Pareto set is the same as the serial one's.
+template <int Capacity>
+void extend_round_parallel(
+  const BasicCsrGraph<Capacity> &g,
+  const Pruning &pruning,
+  const std::vector<size_t> &vertex_indices,
+  std::vector<BasicLabelBucket<Capacity>> &curr,
+  std::vector<BasicLabelBucket<Capacity>> &next,
+  std::vector<LabelHistory> &label_tree,
+  std::vector<std::vector<LabelHistory>> &label_tree_segments,
+  std::vector<size_t> &round_start_sizes,
+  ThreadPool &pool,
+  bool lazy_dominance,
+  std::vector<ExtensionStats> &task_stats,
+  ExtensionStats &stats
+) {
+  constexpr size_t blocks_per_thread = 4; // for load balancing
+  const size_t vertex_count = g.vertex_count();
+  const size_t block_count = std::min(vertex_count, pool.size() * blocks_per_thread);
+  auto block_begin = [&](size_t block_index) { return vertex_count * block_index / block_count; };
+  label_tree_segments.resize(block_count);
+  round_start_sizes.resize(vertex_count);
+  task_stats.assign(block_count, {});
+
+  pool.parallel_for(block_count, [&](size_t block_index, size_t) {
+    const Index first = block_begin(block_index);
+    const Index last = block_begin(block_index + 1);
+    auto &segment = label_tree_segments[block_index];
+    segment.clear();
+    ExtensionStats block_stats; // a local, so that the tasks do not share cache lines
+    for (Index w = first; w < last; ++w) {
+      round_start_sizes[w] = next[w].size();
+    }
+
+    for (auto vertex_index : vertex_indices) {
+      const auto &vertex_labels = curr[vertex_index];
+      if (vertex_labels.empty()) {
+        continue;
+      }
+      const auto targets = g.out_edge_targets(vertex_index);
+      const auto data = g.out_edge_data(vertex_index);
+      for (size_t out_edge_index = 0; out_edge_index != targets.size(); ++out_edge_index) {
+        const Index w = targets[out_edge_index];
+        if (w < first || last <= w) {
+          continue;
+        }
+        const size_t end = extended_labels_end(vertex_labels, data[out_edge_index], w, pruning, false, block_stats);
+        next[w].reserve(next[w].size() + end);
+        for (size_t i = 0; i < end; ++i) {
+          extend_and_handle_domination(
+            vertex_labels, i, data[out_edge_index], pruning, w, next[w], curr[w], vertex_index, out_edge_index, segment,
+            lazy_dominance, true, block_stats
+          );
+        }
+      }
+    }
+    task_stats[block_index] = block_stats;
+  });
+
+  // The labels created by a task refer to its segment, so offset them by where the segment is appended.
+  for (size_t block_index = 0; block_index < block_count; ++block_index) {
+    const size_t offset = label_tree.size();
+    for (auto lh : label_tree_segments[block_index]) {
+      lh.label_tree_index += offset;
+      label_tree.push_back(lh);
+    }
+    for (Index w = block_begin(block_index); w < block_begin(block_index + 1); ++w) {
+      next[w].offset_label_tree_indices(round_start_sizes[w], offset);
+    }
+    stats += task_stats[block_index];
+  }
+
+  for (auto &labels : curr) {
+    labels.clear();
+  }
+}
+
+// search_in_time_order is the label setting alternative to the rounds: the labels are extended in order of increasing
+// time from a monotone bucket queue, i.e. a list per time of the vertices with labels of that time, which needs no
+// sorting since extending a label never decreases its time. Only the vertices in the queue are visited, and a visit
+// settles the vertex's labels of the time, see BasicLabelBucket::settle, and extends them edge by edge, as in the
+// rounds. The labels that wait for a later time are checked against by all new labels of their vertex, and there are
+// more of them than the labels of a round, so this schedule makes fewer labels but more dominance checks.
+// compact_label_tree_if_needed is called after each time, and times itself, so only the extensions of each time are
+// added to the extension time. The settling of the labels is not timed separately, so it is part of the extension time.
+template <int Capacity, typename CompactLabelTree>
+void search_in_time_order(
+  const BasicCsrGraph<Capacity> &g,
+  const Pruning &pruning,
+  Index source_index,
+  Index target_index,
+  int initial_time,
+  std::optional<size_t> max_solutions,
+  std::vector<BasicLabelBucket<Capacity>> &labels, // labels of each vertex, with the initial label at the source
+  std::vector<LabelHistory> &label_tree,
+  std::vector<std::vector<Index>> &time_queue,
+  std::vector<Index> &batch,
+  const CompactLabelTree &compact_label_tree_if_needed,
+  SearchStats &stats
+) {
+  auto &counters = stats.counters;
+  // No label ends after the latest end of an edge, so the queue needs one list per time up to it.
+  int latest_end = initial_time;
+  for (Index v = 0; v < g.vertex_count(); ++v) {
+    for (const auto &data : g.out_edge_data(v)) {
+      ASSERT_ALWAYS(data.time_change >= 0);
+      latest_end = std::max(latest_end, std::max(data.latest_time, data.earliest_time) + data.time_change);
+    }
+  }
+  const size_t time_count = static_cast<size_t>(latest_end - initial_time) + 1;
+  if (time_queue.size() < time_count) {
+    time_queue.resize(time_count);
+  }
+  for (size_t t = 0; t < time_count; ++t) {
+    time_queue[t].clear();
+  }
+  time_queue[0].push_back(source_index);
+
+  // extend_and_handle_domination checks the new labels against two buckets, the second one is always empty here
+  BasicLabelBucket<Capacity> no_labels;
+  for (size_t t = 0; t < time_count; ++t) {
+    const int time = initial_time + static_cast<int>(t);
+    counters.rounds += static_cast<size_t>(!time_queue[t].empty());
+    timed(stats.extension_time, [&] {
+      // Labels extended along edges without duration are queued at the current time, so process the list in batches.
+      while (!time_queue[t].empty()) {
+        std::swap(batch, time_queue[t]);
+        time_queue[t].clear();
+        std::ranges::sort(batch);
+        const auto [unique_begin, unique_end] = std::ranges::unique(batch);
+        batch.erase(unique_begin, unique_end);
+        for (const Index v : batch) {
+          auto &vertex_labels = labels[v];
+          counters.labels_dominated += vertex_labels.dominated_count(); // settle removes them
+          if constexpr (search_stats) {
+            stats.peak_labels_per_vertex = std::max(stats.peak_labels_per_vertex, vertex_labels.size());
+          }
+          const size_t settled_count = vertex_labels.settle(time);
+          const auto targets = g.out_edge_targets(v);
+          const auto data = g.out_edge_data(v);
+          for (size_t out_edge_index = 0; out_edge_index != targets.size(); ++out_edge_index) {
+            const Index w = targets[out_edge_index];
+            for (size_t i = 0; i < settled_count; ++i) {
+              if (vertex_labels.dominated(i)) {
+                continue;
+              }
+              const size_t new_label_index = labels[w].size();
+              extend_and_handle_domination(
+                vertex_labels, i, data[out_edge_index], pruning, w, labels[w], no_labels, v, out_edge_index, label_tree,
+                false, false, stats.extensions
+              );
+              // The labels at the target are solutions and are not extended.
+              if (labels[w].size() != new_label_index && w != target_index) {
+                time_queue[static_cast<size_t>(labels[w].time(new_label_index) - initial_time)].push_back(w);
+              }
+            }
+          }
+        }
+      }
+    });
+    if (max_solutions && count_solutions(labels[target_index], pruning) >= *max_solutions) {
       return;
     }
-    if (is_dominate(new_state, l.s)) {
-      l.dominated = true;
+    compact_label_tree_if_needed();
+  }
+}
+
+template <int Capacity>
+BasicSolutions<Capacity> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const PingPongOptions &options
+) {
+  BasicPingPongWorkspace<Capacity> workspace;
+  // Copy the solutions out of the workspace's arena.
+  return BasicSolutions<Capacity>(
+    find_ping_pong_solutions(g, source_index, target_index, initial_state, workspace, options)
+  );
+}
+
+template <int Capacity>
+const BasicSolutions<Capacity> &find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  const PingPongOptions &options
+) {
+  workspace.csr_graph.assign(g);
+  return find_ping_pong_solutions(workspace.csr_graph, source_index, target_index, initial_state, workspace, options);
+}
+
+template <int Capacity>
+BasicSolutions<Capacity> find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const PingPongOptions &options
+) {
+  BasicPingPongWorkspace<Capacity> workspace;
+  // Copy the solutions out of the workspace's arena.
+  return BasicSolutions<Capacity>(
+    find_ping_pong_solutions(g, source_index, target_index, initial_state, workspace, options)
+  );
+}
+
+// Sets candidate_graph to g with only the edges into the target and the max_out_edges cheapest out edges of a vertex.
+template <int Capacity>
+void select_candidate_out_edges(
+  const BasicCsrGraph<Capacity> &g,
+  Index target_index,
+  size_t max_out_edges,
+  BasicCsrGraph<Capacity> &candidate_graph,
+  std::vector<Index> &candidate_out_edge_indices,
+  std::vector<Index> &out_edge_order // scratch
+) {
+  // out_edge_order starts with the sorted out_edge_indices of the cheapest out edges of the current vertex
+  auto cheapest_end = out_edge_order.begin();
+  Index current_vertex_index = std::numeric_limits<Index>::max();
+  auto keep = [&](Index vertex_index, Index out_edge_index) {
+    if (vertex_index != current_vertex_index) {
+      current_vertex_index = vertex_index;
+      const auto data = g.out_edge_data(vertex_index);
+      out_edge_order.resize(data.size());
+      std::iota(out_edge_order.begin(), out_edge_order.end(), Index{0});
+      cheapest_end = out_edge_order.begin() + static_cast<std::ptrdiff_t>(std::min(max_out_edges, data.size()));
+      std::ranges::nth_element(out_edge_order.begin(), cheapest_end, out_edge_order.end(), [&data](auto lhs, auto rhs) {
+        return std::tie(data[lhs].cost_change, lhs) < std::tie(data[rhs].cost_change, rhs);
+      });
+      std::sort(out_edge_order.begin(), cheapest_end);
+    }
+    return std::binary_search(out_edge_order.begin(), cheapest_end, out_edge_index) ||
+           g.out_edge_targets(vertex_index)[out_edge_index] == target_index;
+  };
+  candidate_graph.assign_subgraph(g, keep, candidate_out_edge_indices);
+}
+
+// Sorts vertex_indices by the keys of VertexOrder::min_average_cost_change or VertexOrder::topological_by_time, which
+// only depend on the graph, so this is done once per search. The vertices without out edges, or that can not be
+// reached, come last.
+template <int Capacity>
+void order_vertices_by_graph(
+  const BasicCsrGraph<Capacity> &g,
+  VertexOrder order,
+  Index source_index,
+  int initial_time,
+  std::vector<double> &keys,
+  std::vector<size_t> &vertex_indices
+) {
+  const size_t vertex_count = g.vertex_count();
+  keys.assign(vertex_count, std::numeric_limits<double>::infinity());
+  if (order == VertexOrder::min_average_cost_change) {
+    for (Index v = 0; v < vertex_count; ++v) {
+      const auto data = g.out_edge_data(v);
+      if (!data.empty()) {
+        const int64_t sum = std::accumulate(data.begin(), data.end(), int64_t{0}, [](int64_t total, const auto &d) {
+          return total + d.cost_change;
+        });
+        keys[v] = static_cast<double>(sum) / static_cast<double>(data.size());
+      }
+    }
+  } else {
+    ASSERT_ALWAYS(order == VertexOrder::topological_by_time);
+    // The earliest arrival times, by a Dijkstra search in which an edge must be started by its latest_time and waits
+    // for its earliest_time, like extend. Since the time changes are nonnegative, a vertex's time is final when popped.
+    std::priority_queue<std::pair<int, Index>, std::vector<std::pair<int, Index>>, std::greater<>> queue;
+    keys[source_index] = initial_time;
+    queue.emplace(initial_time, source_index);
+    while (!queue.empty()) {
+      const auto [time, v] = queue.top();
+      queue.pop();
+      if (time != keys[v]) {
+        continue; // stale
+      }
+      const auto targets = g.out_edge_targets(v);
+      const auto data = g.out_edge_data(v);
+      for (size_t out_edge_index = 0; out_edge_index < targets.size(); ++out_edge_index) {
+        const auto &d = data[out_edge_index];
+        ASSERT_ALWAYS(d.time_change >= 0);
+        if (time > d.latest_time) {
+          continue;
+        }
+        const int arrival_time = std::max(time, d.earliest_time) + d.time_change;
+        if (arrival_time < keys[targets[out_edge_index]]) {
+          keys[targets[out_edge_index]] = arrival_time;
+          queue.emplace(arrival_time, targets[out_edge_index]);
+        }
+      }
     }
   }
+  std::ranges::sort(vertex_indices, [&keys](size_t lhs_index, size_t rhs_index) {
+    return std::tie(keys[lhs_index], lhs_index) < std::tie(keys[rhs_index], rhs_index);
+  });
+}
 
-  size_t tree_index = label_tree.size();
-  label_tree.emplace_back(old_label.label_tree_index, tree_index, EdgeLocation{node_index, out_edge_index});
-  next_labels.emplace_back(new_state, false, tree_index);
+// Sorts vertex_indices by the labels in curr at the start of a round, for VertexOrder::min_time by the time of the
+// first label, which is the earliest unless the labels are bucketed by time, and for VertexOrder::min_cost by the
+// lowest cost. The vertices without labels come first.
+template <int Capacity>
+void order_vertices_by_labels(
+  VertexOrder order,
+  const std::vector<BasicLabelBucket<Capacity>> &curr,
+  std::vector<double> &keys,
+  std::vector<size_t> &vertex_indices
+) {
+  keys.resize(curr.size());
+  for (const auto [vertex_index, labels] : views::enumerate(curr)) {
+    double &key = keys[vertex_index];
+    if (labels.empty()) {
+      key = -std::numeric_limits<double>::infinity();
+    } else if (order == VertexOrder::min_time) {
+      key = labels.time(0);
+    } else {
+      ASSERT_ALWAYS(order == VertexOrder::min_cost);
+      key = labels.cost(0);
+      for (size_t i = 1; i < labels.size(); ++i) {
+        key = std::min(key, static_cast<double>(labels.cost(i)));
+      }
+    }
+  }
+  std::ranges::sort(vertex_indices, [&keys](size_t lhs_index, size_t rhs_index) {
+    return keys[lhs_index] < keys[rhs_index];
+  });
 }
 
-Solutions find_ping_pong_solutions(const Graph &g, Index source_index, Index target_index, State initial_state) {
+// The search of find_ping_pong_solutions and visit_ping_pong_solutions, which leaves the labels at the target in
+// workspace.curr[target_index] and their paths in workspace.label_tree.
+template <int Capacity>
+void search_ping_pong(
+  const BasicCsrGraph<Capacity> &full_graph,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  const PingPongOptions &options
+) {
   // Note: the ping-pong design tried to avoid pointer chasing when compared with boost::r_c_shortest_paths
 
   ASSERT_ALWAYS(source_index != target_index);
-  const auto &vs = g.get_vertices();
-  ASSERT_ALWAYS(vs[target_index].out_edges.empty());
-  // the algorithm ping-pongs i.e. alternates between:
-  // 1. curr as input and next as output
-  // 2. next as input and curr as output
-  std::vector<std::vector<Label>> curr(vs.size());
-  std::vector<std::vector<Label>> next(vs.size());
-  std::vector<LabelHistory> label_tree;
-  std::vector<size_t> vertex_indices;
-  for (const auto &v : vs) {
-    vertex_indices.push_back(v.index);
+  const bool has_candidate_graph = options.max_out_edges_per_vertex.has_value();
+  if (has_candidate_graph) {
+    select_candidate_out_edges(
+      full_graph, target_index, *options.max_out_edges_per_vertex, workspace.candidate_graph,
+      workspace.candidate_out_edge_indices, workspace.out_edge_order
+    );
+  }
+  // the graph that is searched, the out edge locations of the labels are in it
+  const auto &g = has_candidate_graph ? workspace.candidate_graph : full_graph;
+  const size_t vertex_count = g.vertex_count();
+  ASSERT_ALWAYS(g.out_edge_targets(target_index).empty());
+  auto &curr = workspace.curr;
+  auto &next = workspace.next;
+  auto &label_tree = workspace.label_tree;
+  auto &vertex_indices = workspace.vertex_indices;
+  auto &solutions = workspace.solutions;
+  curr.resize(vertex_count);
+  next.resize(vertex_count);
+  for (auto &labels : curr) {
+    labels.clear();
+  }
+  for (auto &labels : next) {
+    labels.clear();
+  }
+  label_tree.clear();
+  vertex_indices.clear();
+  for (Index vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+    vertex_indices.push_back(vertex_index);
+  }
+  clear_solutions(solutions, workspace.arena);
+  auto &stats = solutions.stats;
+  stats = {};
+  auto &counters = stats.counters;
+
+  Pruning pruning;
+  if (options.prune_with_completion_bounds || options.cost_upper_bound) {
+    compute_completion_bounds(g, target_index, workspace.completion_bounds);
+    pruning.bounds = &workspace.completion_bounds;
+    pruning.cost_upper_bound = options.cost_upper_bound.value_or(std::numeric_limits<int>::max());
   }
 
   { // set up label for the initial state
     size_t label_tree_index = 0;
-    curr[source_index].emplace_back(initial_state, false, label_tree_index);
+    curr[source_index].push_back(initial_state, label_tree_index);
     label_tree.push_back(LabelHistory{ROOT_MARKER, label_tree_index, source_index, 0});
   }
 
-  bool states_not_target = true;
-  while (states_not_target) {
-    // TODO: add some heuristic to prefer creating states that won't be dominated earlier, e.g.
-    //  order vertices by low average or median cost.
-    states_not_target = false;
-    // We skip propagating curr labels at target and get directly to next.
-    ASSERT_ALWAYS(next[target_index].empty());
-    std::swap(curr[target_index], next[target_index]);
+  size_t compaction_size = options.label_tree_compaction_size.value_or(0);
+  size_t compacted_label_count = 0; // the labels removed from the label tree, to count the labels created
+  auto compact_label_tree_if_needed = [&] {
+    counters.peak_label_tree_size = std::max(counters.peak_label_tree_size, label_tree.size());
+    if (options.label_tree_compaction_size && label_tree.size() >= compaction_size) {
+      compacted_label_count += label_tree.size();
+      timed(stats.compaction_time, [&] {
+        compact_label_tree(label_tree, curr, next, workspace.new_label_tree_indices);
+      });
+      compacted_label_count -= label_tree.size();
+      compaction_size = std::max(*options.label_tree_compaction_size, 2 * label_tree.size());
+    }
+  };
 
-    for (auto &labels : curr) {
-      const auto [first, last] =
-        std::ranges::remove_if(labels.begin(), labels.end(), [](const Label &l) { return l.dominated; });
-      labels.erase(first, last);
-      std::ranges::sort(labels, [](auto lhs, auto rhs) { return lhs.s.time < rhs.s.time; });
+  bool swapped = false;
+  if (options.schedule == PingPongSchedule::time_queue) {
+    ASSERT_ALWAYS(options.thread_pool == nullptr && !options.max_labels_per_vertex && !options.time_bucket_width);
+    ASSERT_ALWAYS(!options.lazy_dominance);
+    search_in_time_order(
+      g, pruning, source_index, target_index, initial_state.time, options.max_solutions, curr, label_tree,
+      workspace.time_queue, workspace.time_queue_batch, compact_label_tree_if_needed, stats
+    );
+  } else {
+    ASSERT_ALWAYS(!(options.lazy_dominance && options.time_bucket_width));
+    const bool order_by_labels =
+      options.vertex_order == VertexOrder::min_time || options.vertex_order == VertexOrder::min_cost;
+    if (!order_by_labels) {
+      timed(stats.vertex_ordering_time, [&] {
+        order_vertices_by_graph(
+          g, options.vertex_order, source_index, initial_state.time, workspace.vertex_order_keys, vertex_indices
+        );
+      });
     }
+    auto compact_with_pareto_sweep = [&counters](auto &labels) {
+      counters.labels_dominated += labels.size();
+      labels.compact_with_pareto_sweep();
+      counters.labels_dominated -= labels.size();
+    };
+    bool states_not_target = true;
+    while (states_not_target) {
+      // We skip propagating curr labels at target and get directly to next.
+      ASSERT_ALWAYS(next[target_index].empty());
+      std::swap(curr[target_index], next[target_index]);
 
-    std::ranges::sort(vertex_indices, [&curr](auto lhs_index, auto rhs_index) {
-      const auto &lhs = curr[lhs_index];
-      const auto &rhs = curr[rhs_index];
-      if (lhs.empty() || rhs.empty()) {
-        if (!rhs.empty()) {
-          return true;
+      timed(stats.compaction_time, [&] {
+        if (options.max_labels_per_vertex) {
+          for (Index vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+            // the labels at the target are solutions and are not extended
+            if (vertex_index != target_index) {
+              // The lazy labels are not marked when they are dominated, so sweep them to keep the cheapest of the
+              // nondominated labels. The sweep below then removes the other labels.
+              if (options.lazy_dominance) {
+                compact_with_pareto_sweep(curr[vertex_index]);
+              }
+              curr[vertex_index].keep_cheapest(*options.max_labels_per_vertex);
+            }
+          }
         }
-        return false;
-      }
-      return lhs.front().s.time < rhs.front().s.time;
-    });
+        for (auto &labels : curr) {
+          if constexpr (search_stats) {
+            stats.peak_labels_per_vertex = std::max(stats.peak_labels_per_vertex, labels.size());
+          }
+          if (options.lazy_dominance) {
+            compact_with_pareto_sweep(labels);
+          } else if (options.time_bucket_width) {
+            counters.labels_dominated += labels.dominated_count();
+            labels.compact_and_bucket_by_time(*options.time_bucket_width);
+          } else {
+            counters.labels_dominated += labels.dominated_count();
+            labels.compact_and_sort_by_time();
+          }
+        }
+      });
+      states_not_target = std::ranges::any_of(curr, [](const auto &labels) { return !labels.empty(); });
+      counters.rounds += static_cast<size_t>(states_not_target);
+      compact_label_tree_if_needed();
 
-    for (auto vertex_index : vertex_indices) {
-      const auto &v = vs[vertex_index];
-      auto &vertex_labels = curr[vertex_index];
-      if (vertex_labels.empty()) {
-        continue;
+      if (order_by_labels) {
+        timed(stats.vertex_ordering_time, [&] {
+          order_vertices_by_labels(options.vertex_order, curr, workspace.vertex_order_keys, vertex_indices);
+        });
       }
-      states_not_target = true;
-      // The idea behind looping edge and then states is for more performant memory access
-      // patterns: write all states to one target vertex before switching to another target vertex
-      for (size_t out_edge_index = 0; out_edge_index != v.out_edges.size(); ++out_edge_index) {
-        const auto &e = v.out_edges[out_edge_index];
-        next[e.vertex_index].reserve(next[e.vertex_index].size() + vertex_labels.size());
-        for (const auto &l : vertex_labels) {
-          if (l.dominated) {
-            continue;
-          }
-          extend_and_handle_domination(
-            l, e.data, next[e.vertex_index], curr[e.vertex_index], v.index, out_edge_index, label_tree
+
+      timed(stats.extension_time, [&] {
+        if (options.thread_pool != nullptr) {
+          extend_round_parallel(
+            g, pruning, vertex_indices, curr, next, label_tree, workspace.label_tree_segments,
+            workspace.round_start_sizes, *options.thread_pool, options.lazy_dominance, workspace.task_extension_stats,
+            stats.extensions
+          );
+        } else {
+          extend_round_serial(
+            g, pruning, vertex_indices, curr, next, label_tree, options.lazy_dominance, stats.extensions
           );
         }
+      });
+
+      std::swap(curr, next);
+      swapped = !swapped;
+
+      if (options.max_solutions) {
+        if (options.lazy_dominance) {
+          compact_with_pareto_sweep(curr[target_index]);
+        }
+        if (count_solutions(curr[target_index], pruning) >= *options.max_solutions) {
+          break;
+        }
       }
-      vertex_labels.clear();
     }
-
-    std::swap(curr, next);
+    if (options.lazy_dominance) {
+      // The labels at the target are not extended, so they are not compacted at the start of a round.
+      compact_with_pareto_sweep(curr[target_index]);
+    }
   }
 
   for (const auto [index, lh] : views::enumerate(label_tree)) {
     ASSERT_ALWAYS(static_cast<Index>(index) == lh.label_tree_index);
   }
 
-  auto nondominated_target_labels = curr[target_index] | views::filter([](auto l) { return !l.dominated; });
-  auto nondominated_target_states = nondominated_target_labels | views::transform([](auto l) { return l.s; });
+  if (has_candidate_graph) {
+    // Map the out edge locations of the labels to the input graph, which the paths and reprice_ping_pong_solutions
+    // use. The root has no edge.
+    for (auto &lh : label_tree | views::drop(1)) {
+      lh.edge_location.out_edge_index = workspace.candidate_out_edge_indices[g.edge_position(lh.edge_location)];
+    }
+  }
+  workspace.repriceable = true;
+  workspace.target_index = target_index;
+  workspace.initial_state = initial_state;
 
-  std::vector<std::vector<EdgeLocation>> nondominated_paths;
-  for (const auto &l : nondominated_target_labels) {
-    std::vector<EdgeLocation> path;
-    Index label_tree_index = l.label_tree_index;
-    while (label_tree_index != ROOT_MARKER) {
-      const auto &lh = label_tree[label_tree_index];
-      path.push_back(lh.edge_location);
-      label_tree_index = lh.parent_label_tree_index;
+  if (swapped) {
+    // Swap back so that each bucket has the same role, and hence capacity, at the start of the next call, but keep
+    // the labels at the target in curr.
+    std::swap(curr, next);
+    std::swap(curr[target_index], next[target_index]);
+  }
+  counters.labels_created = label_tree.size() - 1 + compacted_label_count;
+  counters.labels_dominated += curr[target_index].dominated_count();
+  counters.peak_label_tree_size = std::max(counters.peak_label_tree_size, label_tree.size());
+}
+
+template <int Capacity>
+const BasicSolutions<Capacity> &find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  const PingPongOptions &options
+) {
+  search_ping_pong(g, source_index, target_index, initial_state, workspace, options);
+  auto &solutions = workspace.solutions;
+  timed(solutions.stats.path_reconstruction_time, [&] {
+    collect_solutions(workspace.curr[target_index], workspace.label_tree, solutions);
+  });
+  return solutions;
+}
+
+template <int Capacity>
+void visit_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  SolutionVisitor<Capacity> visitor,
+  void *visit,
+  const PingPongOptions &options
+) {
+  search_ping_pong(g, source_index, target_index, initial_state, workspace, options);
+  const auto &target_labels = workspace.curr[target_index];
+  const auto &label_tree = workspace.label_tree;
+  auto &order = workspace.solution_order;
+  auto &path = workspace.path;
+  order.clear();
+  for (size_t i = 0; i < target_labels.size(); ++i) {
+    if (!target_labels.dominated(i)) {
+      order.push_back(i);
+    }
+  }
+  std::ranges::sort(order, {}, [&target_labels](size_t i) { return target_labels.cost(i); });
+  for (const size_t i : order) {
+    timed(workspace.solutions.stats.path_reconstruction_time, [&] {
+      path.clear();
+      for (Index label_tree_index = target_labels.label_tree_index(i); label_tree_index != ROOT_MARKER;
+           label_tree_index = label_tree[label_tree_index].parent_label_tree_index) {
+        path.push_back(label_tree[label_tree_index].edge_location);
+      }
+    });
+    if (!visitor(visit, path, target_labels.state(i))) {
+      return;
     }
-    nondominated_paths.push_back(path);
   }
+}
 
-  return Solutions{
-    nondominated_paths, std::vector<State>(nondominated_target_states.begin(), nondominated_target_states.end())
-  };
+template <int Capacity>
+const BasicSolutions<Capacity> &
+reprice_ping_pong_solutions(const BasicCsrGraph<Capacity> &g, BasicPingPongWorkspace<Capacity> &workspace) {
+  ASSERT_ALWAYS(workspace.repriceable);
+  ASSERT_ALWAYS(g.vertex_count() == workspace.curr.size());
+  const auto &label_tree = workspace.label_tree;
+  auto &path = workspace.path;
+  // The labels at the target are collected in their bucket of the last search, which is not used until the next one.
+  auto &target_labels = workspace.curr[workspace.target_index];
+  target_labels.clear();
+  clear_solutions(workspace.solutions, workspace.arena);
+
+  for (size_t label_tree_index = 1; label_tree_index < label_tree.size(); ++label_tree_index) {
+    const auto &edge_location = label_tree[label_tree_index].edge_location;
+    if (g.out_edge_targets(edge_location.source_vertex_index)[edge_location.out_edge_index] !=
+        workspace.target_index) {
+      continue;
+    }
+    // The end states are not stored, so replay the path with the new costs. The path was feasible in the last search
+    // and the feasibility does not depend on the costs.
+    path.clear();
+    for (size_t i = label_tree_index; i != ROOT_MARKER; i = label_tree[i].parent_label_tree_index) {
+      path.push_back(label_tree[i].edge_location);
+    }
+    BasicState<Capacity> state = workspace.initial_state;
+    for (const auto &e : views::reverse(path)) {
+      ASSERT_ALWAYS(extend(state, g.out_edge_data(e.source_vertex_index)[e.out_edge_index], state));
+    }
+    if (!target_labels.is_dominated_or_mark_dominated(state)) {
+      target_labels.push_back(state, label_tree_index);
+    }
+  }
+
+  collect_solutions(target_labels, label_tree, workspace.solutions);
+  return workspace.solutions;
 }
 
+template <int Capacity>
+const BasicSolutions<Capacity> &
+reprice_ping_pong_solutions(const BasicGraph<Capacity> &g, BasicPingPongWorkspace<Capacity> &workspace) {
+  workspace.csr_graph.assign(g);
+  return reprice_ping_pong_solutions(workspace.csr_graph, workspace);
+}
+
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool,
+  std::type_identity_t<std::span<BasicPingPongWorkspace<Capacity>>> workspaces
+) {
+  ASSERT_ALWAYS(workspaces.size() >= pool.size());
+  std::vector<BasicSolutions<Capacity>> solutions(queries.size());
+  pool.parallel_for(queries.size(), [&](size_t query_index, size_t thread_index) {
+    const auto &query = queries[query_index];
+    // Copy the solutions out of the workspace's arena, which the thread's next query resets.
+    solutions[query_index] = BasicSolutions<Capacity>(find_ping_pong_solutions(
+      g, query.source_index, query.target_index, query.initial_state, workspaces[thread_index]
+    ));
+  });
+  return solutions;
+}
+
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool,
+  std::type_identity_t<std::span<BasicPingPongWorkspace<Capacity>>> workspaces
+) {
+  return find_ping_pong_solutions(BasicCsrGraph<Capacity>(g), queries, pool, workspaces);
+}
+
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool
+) {
+  std::vector<BasicPingPongWorkspace<Capacity>> workspaces(pool.size());
+  return find_ping_pong_solutions(g, queries, pool, workspaces);
+}
+
+void log_search_stats(const SearchStats &stats) {
+  const auto &counters = stats.counters;
+  const auto &extensions = stats.extensions;
+  spdlog::info(
+    "search: {} rounds, {} labels created, {} labels dominated, peak label tree size {}", counters.rounds,
+    counters.labels_created, counters.labels_dominated, counters.peak_label_tree_size
+  );
+  if constexpr (search_stats) {
+    spdlog::info(
+      "extensions: {} attempted, {} infeasible, {} pruned, {} dominated, {} dominance checks, "
+      "peak labels per vertex {}",
+      extensions.attempted, extensions.infeasible, extensions.pruned, extensions.dominated,
+      extensions.dominance_checks, stats.peak_labels_per_vertex
+    );
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    spdlog::info(
+      "phases: compaction {:.3f} ms, vertex ordering {:.3f} ms, extension {:.3f} ms, path reconstruction {:.3f} ms",
+      Milliseconds(stats.compaction_time).count(), Milliseconds(stats.vertex_ordering_time).count(),
+      Milliseconds(stats.extension_time).count(), Milliseconds(stats.path_reconstruction_time).count()
+    );
+  }
+}
+
+#define INSTANTIATE_FIND_PING_PONG_SOLUTIONS_FOR(GRAPH, CAPACITY)                                                      \
+  template BasicSolutions<CAPACITY> find_ping_pong_solutions(                                                          \
+    const GRAPH<CAPACITY> &, Index, Index, BasicState<CAPACITY>, const PingPongOptions &                               \
+  );                                                                                                                   \
+  template const BasicSolutions<CAPACITY> &find_ping_pong_solutions(                                                   \
+    const GRAPH<CAPACITY> &,                                                                                           \
+    Index,                                                                                                             \
+    Index,                                                                                                             \
+    BasicState<CAPACITY>,                                                                                              \
+    BasicPingPongWorkspace<CAPACITY> &,                                                                                \
+    const PingPongOptions &                                                                                            \
+  );                                                                                                                   \
+  template std::vector<BasicSolutions<CAPACITY>> find_ping_pong_solutions(                                             \
+    const GRAPH<CAPACITY> &,                                                                                           \
+    std::type_identity_t<std::span<const BasicPingPongQuery<CAPACITY>>>,                                               \
+    ThreadPool &,                                                                                                      \
+    std::type_identity_t<std::span<BasicPingPongWorkspace<CAPACITY>>>                                                  \
+  );
+#define INSTANTIATE_FIND_PING_PONG_SOLUTIONS(CAPACITY)                                                                 \
+  INSTANTIATE_FIND_PING_PONG_SOLUTIONS_FOR(BasicGraph, CAPACITY)                                                       \
+  INSTANTIATE_FIND_PING_PONG_SOLUTIONS_FOR(BasicCsrGraph, CAPACITY)                                                    \
+  template const BasicSolutions<CAPACITY> &reprice_ping_pong_solutions(                                                \
+    const BasicGraph<CAPACITY> &, BasicPingPongWorkspace<CAPACITY> &                                                   \
+  );                                                                                                                   \
+  template const BasicSolutions<CAPACITY> &reprice_ping_pong_solutions(                                                \
+    const BasicCsrGraph<CAPACITY> &, BasicPingPongWorkspace<CAPACITY> &                                                \
+  );                                                                                                                   \
+  template void visit_ping_pong_solutions(                                                                             \
+    const BasicCsrGraph<CAPACITY> &,                                                                                   \
+    Index,                                                                                                             \
+    Index,                                                                                                             \
+    BasicState<CAPACITY>,                                                                                              \
+    BasicPingPongWorkspace<CAPACITY> &,                                                                                \
+    SolutionVisitor<CAPACITY>,                                                                                         \
+    void *,                                                                                                            \
+    const PingPongOptions &                                                                                            \
+  );                                                                                                                   \
+  template std::vector<BasicSolutions<CAPACITY>> find_ping_pong_solutions(                                             \
+    const BasicGraph<CAPACITY> &, std::type_identity_t<std::span<const BasicPingPongQuery<CAPACITY>>>, ThreadPool &    \
+  );
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_FIND_PING_PONG_SOLUTIONS)
+
 } // namespace perf_rcsp
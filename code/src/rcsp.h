@@ -19,21 +19,396 @@
 #ifndef RCSP_GRAPH_H
 #define RCSP_GRAPH_H
 
+#include "arena.h"
+#include "completion_bounds.h"
+#include "csr_graph.h"
 #include "graph.h"
+#include "label_bucket.h"
+#include "thread_pool.h"
 #include "vrp_model.h"
 
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
 namespace perf_rcsp {
 
-struct Solutions {
+// Building with PERF_RCSP_SEARCH_STATS defined, e.g. with the CMake option of the same name, makes the searches
+// collect the statistics of SearchStats that cost more than a counter per round. Otherwise the code that collects
+// them is not compiled, and they are zero.
+#if defined(PERF_RCSP_SEARCH_STATS)
+constexpr bool search_stats = true;
+#else
+constexpr bool search_stats = false;
+#endif
+
+// Counters of a search, e.g. to explain the run times of the benchmarks. They are counted per
+// round, or per time with PingPongSchedule::time_queue, so counting them costs next to nothing.
+struct PingPongCounters {
+  size_t rounds = 0; // with PingPongSchedule::time_queue, the times at which labels were extended
+  size_t labels_created = 0; // the labels that were not dominated when they were created
+  // Of the labels created, those that a later label dominated, or that max_labels_per_vertex dropped, and that were
+  // removed by the end of the search.
+  size_t labels_dominated = 0;
+  size_t peak_label_tree_size = 0;
+};
+
+// What happened to the extensions of the labels along the edges. Only collected with search_stats.
+struct ExtensionStats {
+  size_t attempted = 0;
+  size_t infeasible = 0; // rejected by extend, e.g. by a time window or the energy
+  size_t pruned = 0; // dropped by the completion bounds or the cost upper bound
+  size_t dominated = 0; // discarded since a label at the vertex dominated them
+  // The labels that the new labels were checked against. This is an upper bound since a check stops at the first label
+  // that dominates the new one.
+  size_t dominance_checks = 0;
+
+  ExtensionStats &operator+=(const ExtensionStats &other) {
+    attempted += other.attempted;
+    infeasible += other.infeasible;
+    pruned += other.pruned;
+    dominated += other.dominated;
+    dominance_checks += other.dominance_checks;
+    return *this;
+  }
+};
+
+// The statistics of a search, e.g. to tune the options for instances or to see where the time goes without a
+// profiler. The counters are always counted, the rest only with search_stats.
+struct SearchStats {
+  PingPongCounters counters;
+  ExtensionStats extensions;
+  size_t peak_labels_per_vertex = 0; // counted when the labels of a vertex are compacted
+  // The time spent in each phase of the search: compacting and sorting the labels and the label tree, ordering the
+  // vertices of a round, extending the labels and building the paths of the solutions.
+  std::chrono::nanoseconds compaction_time{};
+  std::chrono::nanoseconds vertex_ordering_time{};
+  std::chrono::nanoseconds extension_time{};
+  std::chrono::nanoseconds path_reconstruction_time{};
+};
+
+// Logs stats with spdlog at the info level.
+void log_search_stats(const SearchStats &stats);
+
+template <int Capacity> struct BasicSolutions {
   // These two vector should have the same size. Applying all edges of the ith element of pareto_optimal_solutions
   // to the initial state should result in the ith end_states.
 
   // Edges of each path are in reverse order
-  std::vector<std::vector<EdgeLocation>> nondominated_paths;
-  std::vector<State> nondominated_end_states;
+  std::pmr::vector<std::pmr::vector<EdgeLocation>> nondominated_paths;
+  std::pmr::vector<BasicState<Capacity>> nondominated_end_states;
+  // The statistics of the search that found the solutions, if it was a ping-pong search.
+  SearchStats stats;
+};
+using Solutions = BasicSolutions<N_DELIVERIES>;
+
+enum class PingPongSchedule {
+  // The labels are extended in rounds: each round extends all labels created by the previous one.
+  rounds,
+  // The labels are extended one time at a time, in order of increasing time, from a monotone bucket queue. The
+  // thread_pool, max_labels_per_vertex and time_bucket_width options are not supported with it.
+  time_queue,
+};
+
+// The order in which a round extends the labels of the vertices. In a serial round, the new labels at a vertex also
+// mark the labels there that they dominate, which are then not extended when the vertex comes later in the round, so
+// an order that extends the labels into a vertex before its own creates fewer labels that are dominated later. The
+// nondominated end states are the same for each order.
+enum class VertexOrder {
+  // By the earliest time of the labels at each vertex, at the start of each round.
+  min_time,
+  // By the lowest cost of the labels at each vertex, at the start of each round.
+  min_cost,
+  // By the average cost_change of the out edges of each vertex, lowest first, computed once per search.
+  min_average_cost_change,
+  // By the earliest time at which each vertex can be reached from the source within the time windows, computed once
+  // per search. Since the time changes are nonnegative, the edges mostly go forward in this order.
+  topological_by_time,
+};
+
+struct PingPongOptions {
+  PingPongSchedule schedule = PingPongSchedule::rounds;
+  // Not used by PingPongSchedule::time_queue, which extends the labels in order of time.
+  VertexOrder vertex_order = VertexOrder::min_time;
+  // If set, each round of the sweep is run in parallel on the pool. The Pareto set is the same as without a pool and
+  // the solutions are the same for any number of threads.
+  ThreadPool *thread_pool = nullptr;
+  // If set, bounds on what is needed to reach the target are computed before the search, see CompletionBounds, and
+  // the labels that can not reach it are dropped as soon as they are created. The solutions are the same.
+  bool prune_with_completion_bounds = false;
+  // If set, only the nondominated paths with a cost below cost_upper_bound are found, e.g. only the columns with a
+  // negative reduced cost. The completion bounds are then used to also drop the labels that can not end below it.
+  std::optional<int> cost_upper_bound;
+  // If set, the labels of each vertex are grouped into time buckets of this width with a counting sort at the start of
+  // each round, instead of being sorted by time, and the dominance checks against them only check one direction
+  // outside the new label's bucket, see BasicLabelBucket::compact_and_bucket_by_time. The nondominated end states are
+  // the same. This pays off when the time windows make many labels at a vertex differ in time.
+  std::optional<int> time_bucket_width;
+  // If set, the new labels of a round are not checked against each other as they are created but only against the
+  // labels of the last round. The dominated ones are removed in one batch per vertex at the start of the next round,
+  // and at the target after the search, see BasicLabelBucket::compact_with_pareto_sweep. The nondominated end states
+  // are the same. Not supported with time_bucket_width or PingPongSchedule::time_queue.
+  bool lazy_dominance = false;
+
+  // Heuristic pricing: when any of the options below is set, the search is no longer exact, i.e. the solutions are
+  // nondominated paths of a restricted search and may miss paths of the exact Pareto set. This is intended for the
+  // early iterations of column generation where any paths with a negative reduced cost will do.
+
+  // If set, at most this many labels are extended from each vertex in each round, the cheapest ones.
+  std::optional<size_t> max_labels_per_vertex;
+  // If set, only this many cheapest out edges of each vertex, and the edges into the target, are searched.
+  std::optional<size_t> max_out_edges_per_vertex;
+  // If set, the search stops after the first round that ends with at least this many nondominated labels at the
+  // target, with cost_upper_bound, if set, e.g. after this many paths with a negative reduced cost are found.
+  std::optional<size_t> max_solutions;
+
+  // If set, the label tree is compacted between rounds once it has at least this many entries and twice as many as
+  // after the last compaction, see compact_label_tree, so that its memory stays proportional to the labels that are
+  // still in the search. The solutions are the same, but reprice_ping_pong_solutions then only reprices the paths that
+  // were kept.
+  std::optional<size_t> label_tree_compaction_size;
 };
 
-Solutions find_ping_pong_solutions(const Graph &g, Index source_index, Index target_index, State initial_state);
+// The type erased visitor of visit_ping_pong_solutions: calls the visitor behind visit with a path and its end state
+// and returns false to stop the visits.
+template <int Capacity>
+using SolutionVisitor =
+  bool (*)(void *visit, std::span<const EdgeLocation> path, const BasicState<Capacity> &end_state);
+
+template <int Capacity> class BasicPingPongWorkspace;
+
+// BasicPingPongWorkspace owns the buffers of find_ping_pong_solutions so that they can be reused across calls, e.g.
+// when pricing the same sized graph repeatedly in a column generation loop. The label buckets and the label tree keep
+// their capacity between calls and the returned paths are allocated from an arena that is reset at the start of each
+// call. After a couple of warm-up calls, solving instances of the same size makes no heap allocations.
+template <int Capacity> class BasicPingPongWorkspace {
+  template <int C>
+  friend const BasicSolutions<C> &find_ping_pong_solutions(
+    const BasicGraph<C> &,
+    Index,
+    Index,
+    BasicState<C>,
+    BasicPingPongWorkspace<C> &,
+    const PingPongOptions &
+  );
+  template <int C>
+  friend const BasicSolutions<C> &find_ping_pong_solutions(
+    const BasicCsrGraph<C> &,
+    Index,
+    Index,
+    BasicState<C>,
+    BasicPingPongWorkspace<C> &,
+    const PingPongOptions &
+  );
+  template <int C>
+  friend void search_ping_pong(
+    const BasicCsrGraph<C> &,
+    Index,
+    Index,
+    BasicState<C>,
+    BasicPingPongWorkspace<C> &,
+    const PingPongOptions &
+  );
+  template <int C>
+  friend void visit_ping_pong_solutions(
+    const BasicCsrGraph<C> &,
+    Index,
+    Index,
+    BasicState<C>,
+    BasicPingPongWorkspace<C> &,
+    SolutionVisitor<C>,
+    void *,
+    const PingPongOptions &
+  );
+  template <int C>
+  friend const BasicSolutions<C> &reprice_ping_pong_solutions(const BasicGraph<C> &, BasicPingPongWorkspace<C> &);
+  template <int C>
+  friend const BasicSolutions<C> &reprice_ping_pong_solutions(const BasicCsrGraph<C> &, BasicPingPongWorkspace<C> &);
+
+  // the algorithm ping-pongs i.e. alternates between:
+  // 1. curr as input and next as output
+  // 2. next as input and curr as output
+  std::vector<BasicLabelBucket<Capacity>> curr;
+  std::vector<BasicLabelBucket<Capacity>> next;
+  std::vector<LabelHistory> label_tree;
+  std::vector<size_t> vertex_indices;
+  // the key of each vertex in the VertexOrder, see order_vertices_by_graph and order_vertices_by_labels
+  std::vector<double> vertex_order_keys;
+  // used by the parallel rounds
+  std::vector<std::vector<LabelHistory>> label_tree_segments;
+  std::vector<size_t> round_start_sizes;
+  std::vector<ExtensionStats> task_extension_stats;
+  // used by the label tree compactions
+  std::vector<size_t> new_label_tree_indices;
+  // used by PingPongSchedule::time_queue
+  std::vector<std::vector<Index>> time_queue;
+  std::vector<Index> time_queue_batch;
+  // the CSR copy of a BasicGraph that is solved with this workspace
+  BasicCsrGraph<Capacity> csr_graph;
+  // the graph with only the candidate out edges when max_out_edges_per_vertex is set, see candidate_out_edge_indices
+  BasicCsrGraph<Capacity> candidate_graph;
+  std::vector<Index> candidate_out_edge_indices;
+  std::vector<Index> out_edge_order;
+  CompletionBounds completion_bounds;
+  // the query of the last search and the buffers of reprice_ping_pong_solutions
+  bool repriceable = false;
+  Index target_index = 0;
+  BasicState<Capacity> initial_state;
+  std::vector<EdgeLocation> path;
+  // the target labels in cost order, used by visit_ping_pong_solutions
+  std::vector<size_t> solution_order;
+  Arena arena;
+  BasicSolutions<Capacity> solutions{
+    std::pmr::vector<std::pmr::vector<EdgeLocation>>(&arena), std::pmr::vector<BasicState<Capacity>>(&arena)
+  };
+
+public:
+  // The statistics of the last search, also when the solutions were visited instead of returned.
+  [[nodiscard]] const SearchStats &stats() const { return solutions.stats; }
+  [[nodiscard]] const PingPongCounters &counters() const { return solutions.stats.counters; }
+  // The order in which the last round of the last search extended the vertices, see VertexOrder.
+  [[nodiscard]] std::span<const size_t> vertex_order() const { return vertex_indices; }
+};
+using PingPongWorkspace = BasicPingPongWorkspace<N_DELIVERIES>;
+
+// find_ping_pong_solutions is instantiated for each capacity in PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY, so that
+// instances with few deliveries can use the faster narrow delivery sets.
+template <int Capacity>
+BasicSolutions<Capacity> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const PingPongOptions &options = {}
+);
+
+// Same as above but uses the buffers of workspace. The returned solutions are owned by the workspace and are valid
+// until the next call with the same workspace.
+template <int Capacity>
+const BasicSolutions<Capacity> &find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  const PingPongOptions &options = {}
+);
+
+// The solver runs on the CSR form of the graph, so the two overloads above first copy g into one. When the same
+// graph is solved repeatedly, convert it once and use these overloads instead.
+template <int Capacity>
+BasicSolutions<Capacity> find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  const PingPongOptions &options = {}
+);
+
+template <int Capacity>
+const BasicSolutions<Capacity> &find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  const PingPongOptions &options = {}
+);
+
+// visit_ping_pong_solutions searches as the workspace overload above does, but instead of returning the solutions it
+// calls visit(path, end_state) for each of them in order of increasing cost, ties in an unspecified order. path has
+// the edges in reverse order, as in BasicSolutions, and is a view of a buffer of the workspace that is reused for the
+// next path, so nothing is allocated per path. If visit returns false, e.g. after the first k columns, the remaining
+// paths are not visited. This only saves building the remaining paths, see max_solutions to stop the search early.
+template <int Capacity>
+void visit_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  SolutionVisitor<Capacity> visitor,
+  void *visit,
+  const PingPongOptions &options = {}
+);
+
+template <int Capacity, typename Visit>
+void visit_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  Index source_index,
+  Index target_index,
+  BasicState<Capacity> initial_state,
+  BasicPingPongWorkspace<Capacity> &workspace,
+  Visit &&visit,
+  const PingPongOptions &options = {}
+) {
+  // Erase the type of visit, as ThreadPool::parallel_for does, so that the search is not instantiated per visitor. A
+  // const visit is cast back to const before it is called.
+  const SolutionVisitor<Capacity> visitor = [](void *v, std::span<const EdgeLocation> path,
+                                               const BasicState<Capacity> &end_state) -> bool {
+    return (*static_cast<std::remove_reference_t<Visit> *>(v))(path, end_state);
+  };
+  visit_ping_pong_solutions(
+    g, source_index, target_index, initial_state, workspace, visitor,
+    const_cast<void *>(static_cast<const void *>(std::addressof(visit))), options
+  );
+}
+
+// reprice_ping_pong_solutions is an incremental re-solve for when only the costs of the graph changed since the last
+// search with workspace, e.g. the duals in column generation. g must be the graph of the last search, or a copy of it,
+// with only other cost_change values. Instead of a new search, the paths in the label tree of the last search are
+// priced with the new costs and the nondominated paths among those that end at the target are returned. The time,
+// energy and deliveries of these paths do not depend on the costs, so they stay feasible, but since the last search
+// dropped the labels that were dominated with the old costs, the solutions may miss paths of the exact Pareto set,
+// i.e. this is a heuristic. It may be called repeatedly for one search.
+template <int Capacity>
+const BasicSolutions<Capacity> &
+reprice_ping_pong_solutions(const BasicGraph<Capacity> &g, BasicPingPongWorkspace<Capacity> &workspace);
+
+template <int Capacity>
+const BasicSolutions<Capacity> &
+reprice_ping_pong_solutions(const BasicCsrGraph<Capacity> &g, BasicPingPongWorkspace<Capacity> &workspace);
+
+// A query of the batch find_ping_pong_solutions, e.g. one per vehicle type or depot.
+template <int Capacity> struct BasicPingPongQuery {
+  Index source_index = 0;
+  Index target_index = 0;
+  BasicState<Capacity> initial_state;
+};
+using PingPongQuery = BasicPingPongQuery<N_DELIVERIES>;
+
+// Solves the queries concurrently on pool and returns the solutions of the i-th query as the i-th element. Each thread
+// of the pool solves with its own element of workspaces, so workspaces must have at least pool.size() elements. Keeping
+// the workspaces between batches avoids reallocating their buffers, e.g. in each column generation iteration.
+// Each query is solved with serial rounds, i.e. the pool is not passed on to the single query solves.
+// The span types are not deduced, so that e.g. vectors can be passed.
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool,
+  std::type_identity_t<std::span<BasicPingPongWorkspace<Capacity>>> workspaces
+);
+
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicCsrGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool,
+  std::type_identity_t<std::span<BasicPingPongWorkspace<Capacity>>> workspaces
+);
+
+// Same as above but with workspaces that only live for the call.
+template <int Capacity>
+std::vector<BasicSolutions<Capacity>> find_ping_pong_solutions(
+  const BasicGraph<Capacity> &g,
+  std::type_identity_t<std::span<const BasicPingPongQuery<Capacity>>> queries,
+  ThreadPool &pool
+);
 
 } // namespace perf_rcsp
 
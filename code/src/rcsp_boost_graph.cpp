@@ -47,16 +47,21 @@ void output_graph_as_dot(const BoostGraph &graph, bool show_travel_edges_label,
   boost::write_graphviz(ofs, graph, vertex_writer, edge_writer);
 };
 
-BoostSolutions find_boost_solutions(const SourceTargetBoostGraph &graph, const State &initial_state) {
+template <int Capacity>
+BasicBoostSolutions<Capacity>
+find_boost_solutions(const BasicSourceTargetBoostGraph<Capacity> &graph, const BasicState<Capacity> &initial_state) {
+  using Graph = BasicBoostGraph<Capacity>;
+  using State = BasicState<Capacity>;
+
   class Extension {
   public:
     bool operator()(
-      const BoostGraph &g,
+      const Graph &g,
       State &new_cont,
       const State &old_cont,
-      const boost::graph_traits<BoostGraph>::edge_descriptor &ed
+      const typename boost::graph_traits<Graph>::edge_descriptor &ed
     ) const {
-      const ExtensionData &extension_data = get(boost::edge_bundle, g)[ed];
+      const BasicExtensionData<Capacity> &extension_data = get(boost::edge_bundle, g)[ed];
       return extend(old_cont, extension_data, new_cont);
     }
   };
@@ -68,14 +73,21 @@ BoostSolutions find_boost_solutions(const SourceTargetBoostGraph &graph, const S
     }
   };
 
-  BoostSolutions solutions;
+  BasicBoostSolutions<Capacity> solutions;
   const auto &g = graph.graph;
   boost::r_c_shortest_paths(
-    g, get(&BoostVertex::index, g), get(&ExtensionData::index, g), graph.source_vertex, graph.target_vertex,
-    solutions.nondominated_paths, solutions.nondominated_end_states, initial_state, Extension(), Dominance()
+    g, get(&BoostVertex::index, g), get(&BasicExtensionData<Capacity>::index, g), graph.source_vertex,
+    graph.target_vertex, solutions.nondominated_paths, solutions.nondominated_end_states, initial_state, Extension(),
+    Dominance()
   );
 
   return solutions;
 }
 
+#define INSTANTIATE_FIND_BOOST_SOLUTIONS(CAPACITY)                                                                     \
+  template BasicBoostSolutions<CAPACITY> find_boost_solutions(                                                         \
+    const BasicSourceTargetBoostGraph<CAPACITY> &, const BasicState<CAPACITY> &                                        \
+  );
+PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(INSTANTIATE_FIND_BOOST_SOLUTIONS)
+
 } // namespace perf_rcsp
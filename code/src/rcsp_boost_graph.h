@@ -32,22 +32,28 @@ struct BoostVertex {
   auto operator<=>(const BoostVertex &) const = default;
 };
 
-using BoostGraph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, BoostVertex, ExtensionData>;
+template <int Capacity>
+using BasicBoostGraph =
+  boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, BoostVertex, BasicExtensionData<Capacity>>;
+using BoostGraph = BasicBoostGraph<N_DELIVERIES>;
 
-struct SourceTargetBoostGraph {
+template <int Capacity> struct BasicSourceTargetBoostGraph {
   Index source_vertex = -1;
   Index target_vertex = -1;
-  BoostGraph graph;
+  BasicBoostGraph<Capacity> graph;
 };
+using SourceTargetBoostGraph = BasicSourceTargetBoostGraph<N_DELIVERIES>;
 
-struct BoostSolutions {
+template <int Capacity> struct BasicBoostSolutions {
   // These two vector should have the same size. Applying all edges of the ith element of pareto_optimal_solutions
   // to the initial state should result in the ith end_states.
 
   // Edges of each path are in reverse order
-  std::vector<std::vector<boost::graph_traits<BoostGraph>::edge_descriptor>> nondominated_paths;
-  std::vector<State> nondominated_end_states;
+  std::vector<std::vector<typename boost::graph_traits<BasicBoostGraph<Capacity>>::edge_descriptor>>
+    nondominated_paths;
+  std::vector<BasicState<Capacity>> nondominated_end_states;
 };
+using BoostSolutions = BasicBoostSolutions<N_DELIVERIES>;
 
 // output the graph to the DOT file format to standard out.
 // See: https://graphviz.org/doc/info/lang.html
@@ -56,7 +62,10 @@ struct BoostSolutions {
 // svg: dot -Kneato -Tsvg graph.dot -o graph.svg
 void output_graph_as_dot(const BoostGraph &graph, bool show_travel_edges_label, std::ostream &ofs);
 
-BoostSolutions find_boost_solutions(const SourceTargetBoostGraph &graph, const State &initial_state);
+// find_boost_solutions is instantiated for each capacity in PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY.
+template <int Capacity>
+BasicBoostSolutions<Capacity>
+find_boost_solutions(const BasicSourceTargetBoostGraph<Capacity> &graph, const BasicState<Capacity> &initial_state);
 
 } // namespace perf_rcsp
 
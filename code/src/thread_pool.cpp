@@ -0,0 +1,137 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "thread_pool.h"
+
+#include "util.h"
+
+#include <limits>
+
+namespace perf_rcsp {
+
+namespace {
+uint64_t pack(uint64_t begin, uint64_t end) { return begin | end << 32; }
+uint64_t begin_of(uint64_t packed) { return packed & 0xffffffff; }
+uint64_t end_of(uint64_t packed) { return packed >> 32; }
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count) : task_ranges(std::make_unique<TaskRange[]>(thread_count)) {
+  ASSERT_ALWAYS(thread_count >= 1);
+  for (size_t thread_index = 1; thread_index < thread_count; ++thread_index) {
+    workers.emplace_back([this, thread_index] { worker_loop(thread_index); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock(mutex);
+    stopping = true;
+  }
+  work_available.notify_all();
+  // the jthreads join on destruction
+}
+
+void ThreadPool::run(size_t task_count, Invoker invoker, void *task) {
+  if (task_count == 0) {
+    return;
+  }
+  if (workers.empty()) {
+    for (size_t task_index = 0; task_index < task_count; ++task_index) {
+      invoker(task, task_index, 0);
+    }
+    return;
+  }
+
+  ASSERT_ALWAYS(task_count <= std::numeric_limits<uint32_t>::max());
+  {
+    std::scoped_lock lock(mutex);
+    current_invoker = invoker;
+    current_task = task;
+    for (size_t thread_index = 0; thread_index < size(); ++thread_index) {
+      task_ranges[thread_index].packed.store(
+        pack(task_count * thread_index / size(), task_count * (thread_index + 1) / size()), std::memory_order_relaxed
+      );
+    }
+    busy_workers = workers.size();
+    ++generation;
+  }
+  work_available.notify_all();
+
+  work(0);
+
+  std::unique_lock lock(mutex);
+  work_done.wait(lock, [this] { return busy_workers == 0; });
+}
+
+bool ThreadPool::pop_front(TaskRange &range, size_t &task_index) {
+  uint64_t packed = range.packed.load(std::memory_order_relaxed);
+  do {
+    if (begin_of(packed) == end_of(packed)) {
+      return false;
+    }
+  } while (!range.packed.compare_exchange_weak(packed, pack(begin_of(packed) + 1, end_of(packed))));
+  task_index = begin_of(packed);
+  return true;
+}
+
+bool ThreadPool::pop_back(TaskRange &range, size_t &task_index) {
+  uint64_t packed = range.packed.load(std::memory_order_relaxed);
+  do {
+    if (begin_of(packed) == end_of(packed)) {
+      return false;
+    }
+  } while (!range.packed.compare_exchange_weak(packed, pack(begin_of(packed), end_of(packed) - 1)));
+  task_index = end_of(packed) - 1;
+  return true;
+}
+
+void ThreadPool::work(size_t thread_index) {
+  size_t task_index = 0;
+  while (pop_front(task_ranges[thread_index], task_index)) {
+    current_invoker(current_task, task_index, thread_index);
+  }
+  // Steal from the other threads, starting with the next one so that the thieves spread out. A range never grows
+  // during a parallel_for, so one pass over the threads suffices.
+  for (size_t i = 1; i < size(); ++i) {
+    auto &victim = task_ranges[(thread_index + i) % size()];
+    while (pop_back(victim, task_index)) {
+      current_invoker(current_task, task_index, thread_index);
+    }
+  }
+}
+
+void ThreadPool::worker_loop(size_t thread_index) {
+  size_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      work_available.wait(lock, [&] { return stopping || generation != seen_generation; });
+      if (stopping) {
+        return;
+      }
+      seen_generation = generation;
+    }
+
+    work(thread_index);
+
+    {
+      std::scoped_lock lock(mutex);
+      --busy_workers;
+    }
+    work_done.notify_one();
+  }
+}
+
+} // namespace perf_rcsp
@@ -0,0 +1,86 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace perf_rcsp {
+
+// ThreadPool runs the tasks of parallel_for on a fixed set of worker threads. The calling thread also runs tasks, so
+// a pool of size n starts n - 1 worker threads.
+//
+// The tasks are scheduled by work stealing: each thread starts with a contiguous range of the task indices and runs
+// them from the front, and a thread that has run out of tasks takes tasks from the back of another thread's range.
+// Tasks of uneven length, e.g. solves of different sizes, are then balanced without a shared queue.
+class ThreadPool {
+public:
+  // hardware_concurrency may return 0 when it is not known.
+  explicit ThreadPool(size_t thread_count = std::max(1u, std::thread::hardware_concurrency()));
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  [[nodiscard]] size_t size() const { return workers.size() + 1; }
+
+  // Calls task(task_index, thread_index) for every task_index in [0, task_count) and returns when all calls have
+  // returned. thread_index is in [0, size()) and identifies the thread, e.g. to index per-thread buffers.
+  template <typename Task> void parallel_for(size_t task_count, Task &&task) {
+    auto invoker = [](void *t, size_t task_index, size_t thread_index) {
+      (*static_cast<std::remove_reference_t<Task> *>(t))(task_index, thread_index);
+    };
+    run(task_count, invoker, &task);
+  }
+
+private:
+  using Invoker = void (*)(void *task, size_t task_index, size_t thread_index);
+
+  // The task indices [begin, end) left to a thread, packed into one word so that it can be updated with one CAS.
+  struct alignas(64) TaskRange {
+    std::atomic<uint64_t> packed = 0;
+  };
+  static bool pop_front(TaskRange &range, size_t &task_index);
+  static bool pop_back(TaskRange &range, size_t &task_index);
+
+  void run(size_t task_count, Invoker invoker, void *task);
+  void work(size_t thread_index);
+  void worker_loop(size_t thread_index);
+
+  std::vector<std::jthread> workers;
+  std::mutex mutex;
+  std::condition_variable work_available;
+  std::condition_variable work_done;
+  size_t generation = 0; // incremented for each parallel_for
+  bool stopping = false;
+  size_t busy_workers = 0;
+
+  Invoker current_invoker = nullptr;
+  void *current_task = nullptr;
+  std::unique_ptr<TaskRange[]> task_ranges; // one per thread
+};
+
+} // namespace perf_rcsp
+
+#endif // THREAD_POOL_H
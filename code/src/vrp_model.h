@@ -18,7 +18,16 @@
 
 #include "util.h"
 
-#include <bitset>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 namespace perf_rcsp {
 using Index = size_t;
@@ -29,41 +38,166 @@ struct Site {
   auto operator<=>(const Site &) const = default;
 };
 
+// The delivery capacity, i.e. the maximum number of deliveries, is a template parameter of the model. Each capacity
+// that the solvers are instantiated for is listed here, and N_DELIVERIES is the default capacity that small
+// instances use.
+#define PERF_RCSP_FOR_EACH_DELIVERY_CAPACITY(X) X(32) X(64) X(128) X(256)
 constexpr int N_DELIVERIES = 32;
-constexpr int NOT_A_DELIVERY_MARKER = N_DELIVERIES;
 
-struct ExtensionData {
+// The label buckets store the times and energies of the labels as LabelTime and LabelEnergy. Building with
+// PERF_RCSP_COMPACT_LABELS defined, e.g. with the CMake option of the same name, narrows them to 16 bits, which halves
+// the memory of the labels for instances whose times and energies fit, see fits_in_labels.
+#if defined(PERF_RCSP_COMPACT_LABELS)
+constexpr bool compact_labels = true;
+#else
+constexpr bool compact_labels = false;
+#endif
+using LabelTime = std::conditional_t<compact_labels, int16_t, int>;
+using LabelEnergy = std::conditional_t<compact_labels, int16_t, int>;
+
+template <int Capacity> constexpr int not_a_delivery_marker = Capacity;
+constexpr int NOT_A_DELIVERY_MARKER = not_a_delivery_marker<N_DELIVERIES>;
+
+template <int Capacity> struct BasicExtensionData {
   Index index = -1; // added for use with and comparison with r_c_shortest_paths
   int earliest_time = 0;
   int latest_time = 0;
   int cost_change = 0;
   int time_change = 0;
   int energy_change = 0;
-  int delivery_index = NOT_A_DELIVERY_MARKER;
-  auto operator<=>(const ExtensionData &) const = default;
+  int delivery_index = not_a_delivery_marker<Capacity>;
+  auto operator<=>(const BasicExtensionData &) const = default;
+};
+using ExtensionData = BasicExtensionData<N_DELIVERIES>;
+
+// BasicHotExtensionData holds the fields of BasicExtensionData that extend reads, i.e. without the index that is only
+// used for the comparison with r_c_shortest_paths, so that more edges fit in a cache line in the label loop.
+template <int Capacity> struct BasicHotExtensionData {
+  int earliest_time = 0;
+  int latest_time = 0;
+  int cost_change = 0;
+  int time_change = 0;
+  int energy_change = 0;
+  int delivery_index = not_a_delivery_marker<Capacity>;
+
+  constexpr BasicHotExtensionData() = default;
+  constexpr explicit BasicHotExtensionData(const BasicExtensionData<Capacity> &data)
+    : earliest_time(data.earliest_time), latest_time(data.latest_time), cost_change(data.cost_change),
+      time_change(data.time_change), energy_change(data.energy_change), delivery_index(data.delivery_index) {}
+  auto operator<=>(const BasicHotExtensionData &) const = default;
+};
+using HotExtensionData = BasicHotExtensionData<N_DELIVERIES>;
+
+// BasicDeliverySet is a set of deliveries stored as a fixed width integer mask: the i-th bit is set if and only if
+// the i-th delivery is in the set. Set operations are then integer operations instead of per-bit loops.
+// A capacity of 32 uses one 32-bit word and larger capacities use an array of 64-bit words.
+template <int Capacity> class BasicDeliverySet {
+  static_assert(Capacity == 32 || (Capacity > 0 && Capacity % 64 == 0));
+
+public:
+  using Word = std::conditional_t<Capacity == 32, uint32_t, uint64_t>;
+  static constexpr int word_bits = sizeof(Word) * 8;
+  static constexpr int word_count = Capacity / word_bits;
+  using Mask = Word; // the mask type of single word sets
+
+  constexpr BasicDeliverySet() = default;
+  constexpr explicit BasicDeliverySet(Word mask)
+    requires(word_count == 1)
+    : words{mask} {}
+
+  [[nodiscard]] static constexpr size_t size() { return Capacity; }
+  [[nodiscard]] constexpr bool test(size_t i) const { return (words[i / word_bits] >> (i % word_bits)) & Word{1}; }
+  constexpr BasicDeliverySet &set(size_t i) {
+    words[i / word_bits] |= Word{1} << (i % word_bits);
+    return *this;
+  }
+  // Returns the number of deliveries in the set.
+  [[nodiscard]] constexpr int count() const {
+    int n = 0;
+    for (int i = 0; i < word_count; ++i) {
+      n += std::popcount(words[i]);
+    }
+    return n;
+  }
+  // Return true if and only if every delivery in this set is also in rhs.
+  [[nodiscard]] constexpr bool is_subset_of(const BasicDeliverySet &rhs) const;
+  // Return true if and only if no delivery is in both this set and rhs.
+  [[nodiscard]] constexpr bool is_disjoint_from(const BasicDeliverySet &rhs) const {
+    Word in_both = 0;
+    for (int i = 0; i < word_count; ++i) {
+      in_both |= words[i] & rhs.words[i];
+    }
+    return in_both == 0;
+  }
+  constexpr BasicDeliverySet &operator|=(const BasicDeliverySet &rhs) {
+    for (int i = 0; i < word_count; ++i) {
+      words[i] |= rhs.words[i];
+    }
+    return *this;
+  }
+  [[nodiscard]] constexpr Mask to_mask() const
+    requires(word_count == 1)
+  {
+    return words[0];
+  }
+  bool operator==(const BasicDeliverySet &) const = default;
+
+private:
+  std::array<Word, word_count> words = {};
 };
+using DeliverySet = BasicDeliverySet<N_DELIVERIES>;
 
-struct State { // Also known as a "resource container".
+template <int Capacity>
+constexpr bool BasicDeliverySet<Capacity>::is_subset_of(const BasicDeliverySet &rhs) const {
+  if !consteval {
+    // Test all words with one instruction, testc(a, b) is true if and only if (~a & b) == 0.
+#if defined(__AVX__)
+    if constexpr (sizeof(words) == sizeof(__m256i)) {
+      return _mm256_testc_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs.words.data())),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words.data()))
+      );
+    }
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+    if constexpr (sizeof(words) == sizeof(__m128i)) {
+      return _mm_testc_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs.words.data())),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(words.data()))
+      );
+    }
+#endif
+  }
+  // Accumulate without branching so the compiler can vectorize across words.
+  Word not_in_rhs = 0;
+  for (int i = 0; i < word_count; ++i) {
+    not_in_rhs |= words[i] & ~rhs.words[i];
+  }
+  return not_in_rhs == 0;
+}
+
+template <int Capacity> struct BasicState { // Also known as a "resource container".
   int cost = 0;
   int time = 0;
   int energy = 0;
-  std::bitset<N_DELIVERIES> delivered; // The i-th bit is set if the i-th delivery has been delivered
+  BasicDeliverySet<Capacity> delivered; // The i-th bit is set if the i-th delivery has been delivered
   // Define operators to satisfy
   // https://www.boost.org/doc/libs/1_88_0/libs/graph/doc/r_c_shortest_paths.html
   // "the Less-Than operator for ResourceContainer must compare one or more resource(s) whose resource consumption(s)
   // along any arc is/are non-decreasing in order for the algorithm to work properly."
-  bool operator<=(const State &rhs) const { return time <= rhs.time; }
-  auto operator<=>(const State &rhs) const {
+  bool operator<=(const BasicState &rhs) const { return time <= rhs.time; }
+  auto operator<=>(const BasicState &rhs) const {
     if (*this <= rhs) {
       return rhs <= *this ? std::strong_ordering::equivalent : std::strong_ordering::less;
     }
     return std::strong_ordering::greater;
   }
-  bool operator==(const State &) const = default;
+  bool operator==(const BasicState &) const = default;
 };
+using State = BasicState<N_DELIVERIES>;
 
 // Return true if and only if the lhs State dominate over or equal to the rhs State.
-inline bool is_dominate(const State &lhs, const State &rhs) {
+template <int Capacity> bool is_dominate(const BasicState<Capacity> &lhs, const BasicState<Capacity> &rhs) {
   if (lhs.cost > rhs.cost) {
     return false;
   }
@@ -76,43 +210,85 @@ inline bool is_dominate(const State &lhs, const State &rhs) {
     return false;
   }
 
-  for (size_t i = 0; i < lhs.delivered.size(); ++i) {
-    // Is lhs not a subset of rhs w.r.t. deliveries?
-    if (rhs.delivered.test(i) && !lhs.delivered.test(i)) {
-      return false;
-    }
-  }
+  // Has rhs made a delivery that lhs has not?
+  return rhs.delivered.is_subset_of(lhs.delivered);
+}
 
-  return true;
+// Returns true if the time and energy of state can be stored in a label, see LabelTime and LabelEnergy.
+template <int Capacity> constexpr bool fits_in_labels(const BasicState<Capacity> &state) {
+  return std::in_range<LabelTime>(state.time) && std::in_range<LabelEnergy>(state.energy);
 }
 
-// Extend the update the value of the new_state by "extending" old_state i.e. applying
-// the extension logic to the old_state and the extension_data.
-// Returns true only if the "extension" would result in a valid state.
-inline bool extend(const State &old_state, const ExtensionData &extension_data, State &new_state) {
-  if (extension_data.latest_time < old_state.time) {
+// Returns true if a state with these resources may be extended along the edge of extension_data, i.e. the checks of
+// extend, so that they can be done on the resources of a label before its State is built.
+template <int Capacity, typename ExtensionDataType>
+bool can_extend(
+  int time,
+  int energy,
+  const BasicDeliverySet<Capacity> &delivered,
+  const ExtensionDataType &extension_data
+) {
+  if (extension_data.latest_time < time) {
     return false;
   }
 
-  if (old_state.energy < -extension_data.energy_change) {
+  if (energy < -extension_data.energy_change) {
     return false;
   }
 
-  const bool is_delivery = extension_data.delivery_index < NOT_A_DELIVERY_MARKER;
+  const bool is_delivery = extension_data.delivery_index < not_a_delivery_marker<Capacity>;
   if (is_delivery) {
-    if (bool already_collected = old_state.delivered.test(extension_data.delivery_index); already_collected) {
+    if (bool already_collected = delivered.test(extension_data.delivery_index); already_collected) {
       return false;
     }
   }
+  return true;
+}
 
-  new_state = old_state;
-  new_state.cost += extension_data.cost_change;
-  new_state.time += extension_data.time_change;
-  new_state.energy += extension_data.energy_change;
-  if (is_delivery) {
+// Returns the state with these resources extended along the edge of extension_data, which can_extend must allow. The
+// resources are passed one by one so that the extended state can be built directly from the columns of a label bucket.
+template <int Capacity, typename ExtensionDataType>
+BasicState<Capacity> extend_feasible(
+  int cost,
+  int time,
+  int energy,
+  const BasicDeliverySet<Capacity> &delivered,
+  const ExtensionDataType &extension_data
+) {
+  BasicState<Capacity> new_state{
+    .time = std::max(time, extension_data.earliest_time) + extension_data.time_change,
+    .energy = energy + extension_data.energy_change,
+    .delivered = delivered
+  };
+  if constexpr (compact_labels) {
+    // An overflow would silently corrupt the labels, so check for it where the resources are computed.
+    ASSERT_ALWAYS(!__builtin_add_overflow(cost, extension_data.cost_change, &new_state.cost));
+    ASSERT_ALWAYS(fits_in_labels(new_state));
+  } else {
+    new_state.cost = cost + extension_data.cost_change;
+  }
+  if (extension_data.delivery_index < not_a_delivery_marker<Capacity>) {
     new_state.delivered.set(extension_data.delivery_index);
   }
+  return new_state;
+}
 
+// Extend the update the value of the new_state by "extending" old_state i.e. applying
+// the extension logic to the old_state and the extension_data.
+// The edge must be started by its latest_time and, if old_state is earlier, waits until its earliest_time.
+// Returns true only if the "extension" would result in a valid state.
+// ExtensionDataType is BasicExtensionData<Capacity> or BasicHotExtensionData<Capacity>.
+template <int Capacity, typename ExtensionDataType>
+bool extend(
+  const BasicState<Capacity> &old_state,
+  const ExtensionDataType &extension_data,
+  BasicState<Capacity> &new_state
+) {
+  if (!can_extend(old_state.time, old_state.energy, old_state.delivered, extension_data)) {
+    return false;
+  }
+  new_state =
+    extend_feasible(old_state.cost, old_state.time, old_state.energy, old_state.delivered, extension_data);
   return true;
 }
 } // namespace perf_rcsp
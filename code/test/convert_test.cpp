@@ -86,3 +86,17 @@ TEST(convert, convert_and_convert_back_gives_equal_boost_graph) {
     ASSERT_TRUE(equal_boost_graphs(s_t_g.graph, converted_back));
   }
 }
+
+TEST(convert, generated_graph_equals_converted_generated_boost_graph) {
+  for (const auto family : {InstanceFamily::uniform, InstanceFamily::clustered, InstanceFamily::tight_windows}) {
+    for (int i = 1; i < 40; i++) {
+      SourceTargetBoostGraph s_t_g;
+      int seed = 42 + i;
+      int sites_count = i % (N_DELIVERIES - 1) + 1;
+      generate(family, sites_count, seed, s_t_g);
+      ASSERT_TRUE(
+        equal_boost_graphs(s_t_g.graph, convert_to_boost_graph(generate_graph<N_DELIVERIES>(family, sites_count, seed)))
+      );
+    }
+  }
+}
@@ -0,0 +1,93 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "../../code/src/convert.h"
+#include "../../code/src/csr_graph.h"
+#include "../../code/src/example_graphs.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace perf_rcsp;
+
+TEST(csr_graph, same_out_edges_as_graph) {
+  SourceTargetBoostGraph s_t_g;
+  generate(6, 42, s_t_g);
+  const auto graph = convert_to_graph(s_t_g.graph);
+  const CsrGraph csr_graph(graph);
+
+  const auto &vs = graph.get_vertices();
+  ASSERT_EQ(vs.size(), csr_graph.vertex_count());
+  size_t edge_count = 0;
+  for (const auto &v : vs) {
+    const auto targets = csr_graph.out_edge_targets(v.index);
+    const auto data = csr_graph.out_edge_data(v.index);
+    ASSERT_EQ(v.out_edges.size(), targets.size());
+    ASSERT_EQ(v.out_edges.size(), data.size());
+    for (size_t out_edge_index = 0; out_edge_index < v.out_edges.size(); ++out_edge_index) {
+      const auto &e = v.out_edges[out_edge_index];
+      ASSERT_EQ(e.vertex_index, targets[out_edge_index]);
+      ASSERT_EQ(HotExtensionData(e.data), data[out_edge_index]);
+      ASSERT_EQ(e.data.index, csr_graph.extension_index({v.index, out_edge_index}));
+    }
+    edge_count += v.out_edges.size();
+  }
+  ASSERT_EQ(edge_count, csr_graph.edge_count());
+}
+
+TEST(csr_graph, apply_duals_in_place) {
+  SourceTargetBoostGraph s_t_g;
+  generate(6, 42, s_t_g);
+  auto graph = convert_to_graph(s_t_g.graph);
+  std::vector<int> base_cost_changes;
+  for (Index edge_index = 0; edge_index < graph.edge_count(); ++edge_index) {
+    base_cost_changes.push_back(graph.get_extension_data(edge_index).cost_change);
+  }
+  std::vector<int> duals;
+  for (int delivery_index = 0; delivery_index < N_DELIVERIES; ++delivery_index) {
+    duals.push_back(delivery_index + 1);
+  }
+
+  graph.apply_duals(base_cost_changes, duals);
+  for (Index edge_index = 0; edge_index < graph.edge_count(); ++edge_index) {
+    const auto &data = graph.get_extension_data(edge_index);
+    const int dual = data.delivery_index < NOT_A_DELIVERY_MARKER ? duals[data.delivery_index] : 0;
+    ASSERT_EQ(base_cost_changes[edge_index] - dual, data.cost_change);
+  }
+
+  // The CSR copy of the updated graph is the copy of a graph built with the reduced costs.
+  const auto base_graph = convert_to_graph(s_t_g.graph);
+  Graph rebuilt_graph;
+  for (const auto &v : base_graph.get_vertices()) {
+    rebuilt_graph.add_vertex(v.site);
+  }
+  for (const auto &v : base_graph.get_vertices()) {
+    for (auto e : v.out_edges) {
+      e.data.cost_change -= e.data.delivery_index < NOT_A_DELIVERY_MARKER ? duals[e.data.delivery_index] : 0;
+      rebuilt_graph.add_edge(v.index, e.vertex_index, e.data);
+    }
+  }
+  const CsrGraph csr_graph(graph);
+  const CsrGraph rebuilt_csr_graph(rebuilt_graph);
+  for (Index v = 0; v < csr_graph.vertex_count(); ++v) {
+    ASSERT_TRUE(std::ranges::equal(csr_graph.out_edge_data(v), rebuilt_csr_graph.out_edge_data(v)));
+  }
+
+  graph.set_cost_changes(base_cost_changes);
+  for (Index edge_index = 0; edge_index < graph.edge_count(); ++edge_index) {
+    ASSERT_EQ(base_cost_changes[edge_index], graph.get_extension_data(edge_index).cost_change);
+  }
+}
@@ -0,0 +1,111 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "../../code/src/convert.h"
+#include "../../code/src/example_graphs.h"
+#include "../../code/src/graph_file.h"
+#include "../../code/src/rcsp.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace perf_rcsp;
+
+std::filesystem::path temporary_graph_file_path(const std::string &name) {
+  return std::filesystem::temp_directory_path() /
+         (name + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".graph");
+}
+
+TEST(graph_file, mapped_graph_gives_identical_solutions) {
+  const auto path = temporary_graph_file_path("perf_rcsp");
+  for (int i = 1; i < 15; i++) {
+    SourceTargetBoostGraph s_t_g;
+    generate(i % 7 + 1, 42 + i, s_t_g);
+    const auto graph = convert_to_graph(s_t_g.graph);
+    write_graph_file(path, graph, s_t_g.source_vertex, s_t_g.target_vertex);
+
+    const GraphFile file(path);
+    ASSERT_EQ(s_t_g.source_vertex, file.source_vertex_index());
+    ASSERT_EQ(s_t_g.target_vertex, file.target_vertex_index());
+    ASSERT_EQ(graph.get_vertices().size(), file.sites().size());
+    for (const auto &v : graph.get_vertices()) {
+      ASSERT_EQ(v.site, file.sites()[v.index]);
+    }
+
+    const auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    const auto mapped_solutions =
+      find_ping_pong_solutions(file.csr_graph(), file.source_vertex_index(), file.target_vertex_index(), State{});
+    ASSERT_EQ(solutions.nondominated_paths, mapped_solutions.nondominated_paths);
+    ASSERT_EQ(solutions.nondominated_end_states, mapped_solutions.nondominated_end_states);
+
+    // to_graph gives the same out edges, and a copy of the view shares the mapped arrays
+    const auto copied_graph = file.to_graph();
+    const CsrGraph copied_view = file.csr_graph();
+    ASSERT_EQ(copied_view.all_targets().data(), file.csr_graph().all_targets().data());
+    for (const auto &v : graph.get_vertices()) {
+      ASSERT_EQ(v.out_edges.size(), copied_graph.get_vertices()[v.index].out_edges.size());
+      for (size_t j = 0; j < v.out_edges.size(); ++j) {
+        ASSERT_EQ(v.out_edges[j].vertex_index, copied_graph.get_vertices()[v.index].out_edges[j].vertex_index);
+        ASSERT_EQ(v.out_edges[j].data, copied_graph.get_vertices()[v.index].out_edges[j].data);
+      }
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(graph_file, invalid_files_are_rejected) {
+  const auto path = temporary_graph_file_path("perf_rcsp");
+  SourceTargetBoostGraph s_t_g;
+  generate(5, 42, s_t_g);
+  write_graph_file(path, convert_to_graph(s_t_g.graph), s_t_g.source_vertex, s_t_g.target_vertex);
+  ASSERT_THROW(BasicGraphFile<64>{path}, std::runtime_error); // another capacity
+
+  { // change the source vertex in the header, which the checksum covers too
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(GraphFileHeader, source_vertex_index));
+    const uint64_t source_vertex_index = s_t_g.target_vertex;
+    file.write(reinterpret_cast<const char *>(&source_vertex_index), sizeof(source_vertex_index));
+  }
+  ASSERT_THROW(GraphFile{path}, std::runtime_error);
+  ASSERT_EQ(s_t_g.target_vertex, GraphFile(path, false).source_vertex_index());
+  write_graph_file(path, convert_to_graph(s_t_g.graph), s_t_g.source_vertex, s_t_g.target_vertex);
+
+  { // flip a byte of the last section
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-sizeof(uint64_t), std::ios::end);
+    file.put('\x7f');
+  }
+  ASSERT_THROW(GraphFile{path}, std::runtime_error);
+  const GraphFile unverified_file(path, false);
+  ASSERT_EQ(s_t_g.target_vertex, unverified_file.target_vertex_index());
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - graph_file_alignment);
+  ASSERT_THROW(GraphFile(path, false), std::runtime_error);
+  std::filesystem::remove(path);
+  ASSERT_THROW(GraphFile{path}, std::runtime_error);
+
+  // a delivery index that is neither a delivery nor the marker
+  Graph graph;
+  graph.add_vertex(Site{0, 0});
+  graph.add_vertex(Site{1, 1});
+  graph.add_edge(0, 1, ExtensionData{0, 0, 10, 1, 1, 1, NOT_A_DELIVERY_MARKER});
+  graph.add_edge(1, 0, ExtensionData{1, 0, 10, 1, 1, 1, NOT_A_DELIVERY_MARKER + 1});
+  write_graph_file(path, graph, 0, 1);
+  ASSERT_THROW(GraphFile{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,162 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "../../code/src/label_bucket.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace perf_rcsp;
+
+State random_state(std::mt19937 &gen) {
+  // Small ranges so that dominance in both directions is common.
+  std::uniform_int_distribution<> resource_distribution(0, 4);
+  std::uniform_int_distribution<> delivery_distribution(0, 3);
+  State s{.cost = resource_distribution(gen), .time = resource_distribution(gen), .energy = resource_distribution(gen)};
+  s.delivered.set(delivery_distribution(gen));
+  s.delivered.set(delivery_distribution(gen));
+  return s;
+}
+
+TEST(label_bucket, dominance_equals_is_dominate) {
+  std::mt19937 gen(42);
+  for (int bucket_size = 0; bucket_size < 40; ++bucket_size) {
+    for (int repetition = 0; repetition < 20; ++repetition) {
+      LabelBucket bucket;
+      std::vector<State> states;
+      for (int i = 0; i < bucket_size; ++i) {
+        states.push_back(random_state(gen));
+        bucket.push_back(states.back(), i);
+      }
+      const State candidate = random_state(gen);
+
+      bool expected_dominated = false;
+      for (const auto &s : states) {
+        expected_dominated = expected_dominated || is_dominate(s, candidate);
+      }
+
+      ASSERT_EQ(expected_dominated, bucket.is_dominated_or_mark_dominated(candidate));
+      if (!expected_dominated) {
+        for (int i = 0; i < bucket_size; ++i) {
+          ASSERT_EQ(is_dominate(candidate, states[i]), bucket.dominated(i));
+        }
+      }
+    }
+  }
+}
+
+TEST(label_bucket, bucketed_dominance_equals_is_dominate) {
+  std::mt19937 gen(42);
+  for (int bucket_size = 0; bucket_size < 40; ++bucket_size) {
+    for (int repetition = 0; repetition < 20; ++repetition) {
+      LabelBucket bucket;
+      for (int i = 0; i < bucket_size; ++i) {
+        bucket.push_back(random_state(gen), i);
+      }
+      bucket.compact_and_bucket_by_time(2);
+      // The buckets start at the earliest time.
+      int min_time = 0;
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        min_time = i == 0 ? bucket.time(i) : std::min(min_time, bucket.time(i));
+      }
+      for (size_t i = 1; i < bucket.size(); ++i) {
+        ASSERT_LE((bucket.time(i - 1) - min_time) / 2, (bucket.time(i) - min_time) / 2);
+      }
+      // and some labels that are not bucketed
+      for (int i = 0; i < repetition % 3; ++i) {
+        bucket.push_back(random_state(gen), bucket_size + i);
+      }
+      std::vector<State> states;
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        states.push_back(bucket.state(i));
+      }
+      const State candidate = random_state(gen);
+
+      bool expected_dominated = false;
+      for (const auto &s : states) {
+        expected_dominated = expected_dominated || is_dominate(s, candidate);
+      }
+
+      ASSERT_EQ(expected_dominated, bucket.is_dominated_or_mark_dominated(candidate));
+      if (!expected_dominated) {
+        for (size_t i = 0; i < states.size(); ++i) {
+          ASSERT_EQ(is_dominate(candidate, states[i]), bucket.dominated(i));
+        }
+      }
+    }
+  }
+}
+
+TEST(label_bucket, compact_and_sort_by_time) {
+  LabelBucket bucket;
+  bucket.push_back(State{.cost = 1, .time = 5, .energy = 0}, 1);
+  bucket.push_back(State{.cost = 9, .time = 6, .energy = 0}, 2);
+  bucket.push_back(State{.cost = 2, .time = 3, .energy = 0}, 3);
+  // dominates the second label only
+  ASSERT_FALSE(bucket.is_dominated_or_mark_dominated(State{.cost = 8, .time = 6, .energy = 1}));
+  bucket.compact_and_sort_by_time();
+  ASSERT_EQ(2, bucket.size());
+  ASSERT_EQ(3, bucket.time(0));
+  ASSERT_EQ(3, bucket.label_tree_index(0));
+  ASSERT_EQ(5, bucket.time(1));
+  ASSERT_EQ(1, bucket.label_tree_index(1));
+}
+
+TEST(label_bucket, compact_with_pareto_sweep) {
+  LabelBucket bucket;
+  bucket.push_back(State{.cost = 4, .time = 5, .energy = 0}, 1);
+  // dominates the first label with the same time and cost
+  bucket.push_back(State{.cost = 4, .time = 5, .energy = 2}, 2);
+  bucket.push_back(State{.cost = 2, .time = 7, .energy = 0}, 3);
+  bucket.push_back(State{.cost = 4, .time = 8, .energy = 1}, 4); // dominated by the second label
+  bucket.push_back(State{.cost = 2, .time = 7, .energy = 0}, 5); // equal to the third label
+  bucket.compact_with_pareto_sweep();
+  ASSERT_EQ(2, bucket.size());
+  ASSERT_EQ(2, bucket.label_tree_index(0));
+  ASSERT_EQ(3, bucket.label_tree_index(1));
+  ASSERT_FALSE(bucket.dominated(0));
+  ASSERT_FALSE(bucket.dominated(1));
+}
+
+TEST(label_bucket, end_of_time) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<> time_distribution(0, 20);
+  for (int width : {0, 1, 3}) {
+    LabelBucket bucket;
+    for (size_t i = 0; i < 30; ++i) {
+      // Costs that decrease with time so that no label dominates another.
+      const int time = time_distribution(gen);
+      bucket.push_back(State{.cost = -time, .time = time, .energy = 0}, i);
+    }
+    ASSERT_EQ(bucket.size(), bucket.end_of_time(-1)); // not grouped by time
+    if (width == 0) {
+      bucket.compact_and_sort_by_time();
+    } else {
+      bucket.compact_and_bucket_by_time(width);
+    }
+    for (int time = -1; time <= 21; ++time) {
+      const size_t end = bucket.end_of_time(time);
+      ASSERT_LE(end, bucket.size());
+      for (size_t i = end; i < bucket.size(); ++i) {
+        ASSERT_GT(bucket.time(i), time);
+      }
+      if (width <= 1) { // exact
+        ASSERT_TRUE(end == 0 || bucket.time(end - 1) <= time);
+      }
+    }
+  }
+}
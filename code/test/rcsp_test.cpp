@@ -16,17 +16,70 @@
 // Created by douglas on 7/25/25.
 //
 
+#include "../../code/src/bidirectional.h"
 #include "../../code/src/convert.h"
 #include "../../code/src/example_graphs.h"
 #include "../../code/src/rcsp.h"
 #include "../../code/src/rcsp_boost_graph.h"
 
+#include <algorithm>
+#include <chrono>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace perf_rcsp;
 namespace views = std::views;
 
+namespace {
+
+// A generated instance and its graph.
+struct Instance {
+  SourceTargetBoostGraph s_t_g;
+  Graph graph;
+
+  Instance(int sites_count, int seed, InstanceFamily family = InstanceFamily::uniform) {
+    generate(family, sites_count, seed, s_t_g);
+    graph = convert_to_graph(s_t_g.graph);
+  }
+
+  [[nodiscard]] Solutions solve(const PingPongOptions &options = {}) const {
+    return find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, options);
+  }
+};
+
+// The states sorted by their resources, to compare the end states of searches that find them in different orders.
+std::vector<State> sorted(const auto &states) {
+  std::vector<State> sorted_states(states.begin(), states.end());
+  std::ranges::sort(sorted_states, {}, [](const State &s) {
+    return std::tuple(s.cost, s.time, s.energy, s.delivered.to_mask());
+  });
+  return sorted_states;
+}
+
+const TargetEdge &out_edge(const Graph &graph, const EdgeLocation &edge_location) {
+  return graph.get_vertices()[edge_location.source_vertex_index].out_edges[edge_location.out_edge_index];
+}
+
+// Returns the end state of path, with the edges in reverse order as in BasicSolutions, from the initial state, or
+// std::nullopt if an edge can not be extended.
+std::optional<State> replay(const Graph &graph, std::span<const EdgeLocation> path) {
+  State state;
+  for (const auto &edge_location : views::reverse(path)) {
+    if (!extend(state, out_edge(graph, edge_location).data, state)) {
+      return std::nullopt;
+    }
+  }
+  return state;
+}
+
+} // namespace
+
 TEST(rcsp, boost_gives_identical_number_of_optimal_states) {
   for (int i = 1; i < 100; i++) {
     SourceTargetBoostGraph s_t_g;
@@ -43,3 +96,580 @@ TEST(rcsp, boost_gives_identical_number_of_optimal_states) {
     ASSERT_EQ(boost_solutions.nondominated_end_states.size(), solutions.nondominated_end_states.size());
   }
 }
+
+TEST(rcsp, instance_families_give_identical_number_of_optimal_states) {
+  for (const auto family :
+       {InstanceFamily::clustered, InstanceFamily::tight_windows, InstanceFamily::scarce_chargers}) {
+    for (int i = 1; i < 20; i++) {
+      SourceTargetBoostGraph s_t_g;
+      generate(family, i % 6 + 1, 42 + i, s_t_g);
+      auto boost_solutions = find_boost_solutions(s_t_g, State{});
+      auto graph = convert_to_graph(s_t_g.graph);
+      auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+      ASSERT_EQ(boost_solutions.nondominated_end_states.size(), solutions.nondominated_end_states.size());
+    }
+  }
+}
+
+template <int Capacity> BasicSolutions<Capacity> solve_generated(int sites_count, int seed) {
+  BasicSourceTargetBoostGraph<Capacity> s_t_g;
+  generate(sites_count, seed, s_t_g);
+  auto graph = convert_to_graph(s_t_g.graph);
+  return find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, BasicState<Capacity>{});
+}
+
+TEST(rcsp, capacities_give_identical_solutions) {
+  for (int i = 1; i < 30; i++) {
+    int seed = 42 + i;
+    int sites_count = i % 5 + 1;
+    auto solutions_32 = solve_generated<32>(sites_count, seed);
+    auto solutions_64 = solve_generated<64>(sites_count, seed);
+    auto solutions_256 = solve_generated<256>(sites_count, seed);
+    ASSERT_EQ(solutions_32.nondominated_paths.size(), solutions_64.nondominated_paths.size());
+    ASSERT_EQ(solutions_32.nondominated_paths.size(), solutions_256.nondominated_paths.size());
+    for (size_t j = 0; j < solutions_32.nondominated_end_states.size(); ++j) {
+      const auto &s_32 = solutions_32.nondominated_end_states[j];
+      const auto &s_256 = solutions_256.nondominated_end_states[j];
+      ASSERT_EQ(s_32.cost, s_256.cost);
+      ASSERT_EQ(s_32.time, s_256.time);
+      ASSERT_EQ(s_32.energy, s_256.energy);
+      for (int d = 0; d < N_DELIVERIES; ++d) {
+        ASSERT_EQ(s_32.delivered.test(d), s_256.delivered.test(d));
+      }
+    }
+  }
+}
+
+TEST(rcsp, deliveries_beyond_32) {
+  // source -> site with the deliveries 40 and 130 as self loops -> target
+  using ExtensionData = BasicExtensionData<256>;
+  BasicGraph<256> graph;
+  const Index source = graph.add_vertex({0, 0});
+  const Index site = graph.add_vertex({1, 0});
+  const Index target = graph.add_vertex({0, 1});
+  constexpr int marker = not_a_delivery_marker<256>;
+  graph.add_edge(source, site, ExtensionData{0, 0, 100, 1, 1, 0, marker});
+  graph.add_edge(site, site, ExtensionData{1, 0, 100, -5, 0, 0, 40});
+  graph.add_edge(site, site, ExtensionData{2, 0, 100, -7, 0, 0, 130});
+  graph.add_edge(site, target, ExtensionData{3, 0, 100, 1, 1, 0, marker});
+
+  auto solutions = find_ping_pong_solutions(graph, source, target, BasicState<256>{});
+  // Delivering more never costs more, so the only nondominated path makes both deliveries.
+  ASSERT_EQ(1, solutions.nondominated_end_states.size());
+  const auto &end_state = solutions.nondominated_end_states.front();
+  ASSERT_EQ(-10, end_state.cost);
+  ASSERT_TRUE(end_state.delivered.test(40));
+  ASSERT_TRUE(end_state.delivered.test(130));
+  ASSERT_FALSE(end_state.delivered.test(8));
+  ASSERT_EQ(4, solutions.nondominated_paths.front().size());
+}
+
+TEST(rcsp, workspace_reuse_gives_identical_solutions) {
+  PingPongWorkspace workspace;
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    // vary the size so the workspace is reused for both smaller and larger graphs
+    int sites_count = (i * 7) % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+
+    auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    const auto &workspace_solutions =
+      find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace);
+
+    ASSERT_EQ(solutions.nondominated_end_states, workspace_solutions.nondominated_end_states);
+    ASSERT_EQ(solutions.nondominated_paths, workspace_solutions.nondominated_paths);
+  }
+}
+
+TEST(rcsp, parallel_gives_identical_solutions) {
+  ThreadPool single_thread_pool(1);
+  ThreadPool pool(4);
+  auto by_cost_then_time = [](const State &lhs, const State &rhs) {
+    return std::tie(lhs.cost, lhs.time, lhs.energy) < std::tie(rhs.cost, rhs.time, rhs.energy);
+  };
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+
+    auto serial = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    auto single_thread = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, PingPongOptions{.thread_pool = &single_thread_pool}
+    );
+    auto parallel = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, PingPongOptions{.thread_pool = &pool}
+    );
+
+    // The parallel rounds do not depend on the number of threads.
+    ASSERT_EQ(single_thread.nondominated_end_states, parallel.nondominated_end_states);
+    ASSERT_EQ(single_thread.nondominated_paths, parallel.nondominated_paths);
+
+    // The parallel rounds drop dominated labels at other times than the serial ones, so only the Pareto sets agree.
+    std::ranges::sort(serial.nondominated_end_states, by_cost_then_time);
+    std::ranges::sort(parallel.nondominated_end_states, by_cost_then_time);
+    ASSERT_EQ(serial.nondominated_end_states.size(), parallel.nondominated_end_states.size());
+    for (size_t j = 0; j < serial.nondominated_end_states.size(); ++j) {
+      const auto &s = serial.nondominated_end_states[j];
+      const auto &p = parallel.nondominated_end_states[j];
+      ASSERT_EQ(std::tie(s.cost, s.time, s.energy), std::tie(p.cost, p.time, p.energy));
+    }
+  }
+}
+
+TEST(rcsp, batch_gives_identical_solutions) {
+  ThreadPool pool(3);
+  std::vector<PingPongWorkspace> workspaces(pool.size());
+  for (int i = 1; i < 10; i++) {
+    SourceTargetBoostGraph s_t_g;
+    generate(i % 6 + 1, 42 + i, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+    // e.g. vehicles that start later or with more energy
+    std::vector<PingPongQuery> queries;
+    for (int j = 0; j < 7; ++j) {
+      queries.push_back({s_t_g.source_vertex, s_t_g.target_vertex, State{.time = 5 * j, .energy = 3 * j}});
+    }
+
+    auto batch_solutions = find_ping_pong_solutions(graph, queries, pool, workspaces);
+    ASSERT_EQ(queries.size(), batch_solutions.size());
+    for (size_t j = 0; j < queries.size(); ++j) {
+      const auto &query = queries[j];
+      auto solutions = find_ping_pong_solutions(graph, query.source_index, query.target_index, query.initial_state);
+      ASSERT_EQ(solutions.nondominated_end_states, batch_solutions[j].nondominated_end_states);
+      ASSERT_EQ(solutions.nondominated_paths, batch_solutions[j].nondominated_paths);
+    }
+  }
+}
+
+TEST(rcsp, bidirectional_gives_identical_optimal_states) {
+  auto by_resources = [](const State &lhs, const State &rhs) {
+    return std::tie(lhs.cost, lhs.time, lhs.energy) < std::tie(rhs.cost, rhs.time, rhs.energy);
+  };
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto boost_solutions = find_boost_solutions(s_t_g, State{});
+    auto graph = convert_to_graph(s_t_g.graph);
+    // also split off center to check that the join does not depend on the half way time
+    for (std::optional<int> half_way_time : {std::optional<int>(), std::optional<int>(20), std::optional<int>(80)}) {
+      auto solutions = find_bidirectional_solutions(
+        graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, BidirectionalOptions{half_way_time}
+      );
+      ASSERT_EQ(boost_solutions.nondominated_end_states.size(), solutions.nondominated_end_states.size());
+
+      auto boost_end_states = boost_solutions.nondominated_end_states;
+      std::vector<State> end_states(solutions.nondominated_end_states.begin(), solutions.nondominated_end_states.end());
+      std::ranges::sort(boost_end_states, by_resources);
+      std::ranges::sort(end_states, by_resources);
+      for (size_t j = 0; j < end_states.size(); ++j) {
+        const auto &b = boost_end_states[j];
+        const auto &s = end_states[j];
+        ASSERT_EQ(std::tie(b.cost, b.time, b.energy), std::tie(s.cost, s.time, s.energy));
+      }
+
+      // Replaying each path from the source gives its end state.
+      for (size_t j = 0; j < solutions.nondominated_paths.size(); ++j) {
+        const auto &path = solutions.nondominated_paths[j];
+        ASSERT_EQ(s_t_g.target_vertex, out_edge(graph, path.front()).vertex_index);
+        ASSERT_EQ(solutions.nondominated_end_states[j], replay(graph, path));
+      }
+    }
+  }
+}
+
+TEST(rcsp, completion_bounds_give_identical_solutions) {
+  // The pruning changes the order in which the vertices are swept, so compare the end states as sets.
+  for (int i = 1; i < 30; i++) {
+    const Instance instance(i % 6 + 1, 42 + i);
+    auto solutions = instance.solve();
+    auto pruned_solutions = instance.solve({.prune_with_completion_bounds = true});
+    ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(pruned_solutions.nondominated_end_states));
+
+    // Only the paths that end below the cost upper bound, e.g. those with a negative reduced cost.
+    std::vector<int> costs;
+    for (const auto &s : solutions.nondominated_end_states) {
+      costs.push_back(s.cost);
+    }
+    std::ranges::sort(costs);
+    const int cost_upper_bound = costs[costs.size() / 2];
+    auto bounded_solutions = instance.solve({.cost_upper_bound = cost_upper_bound});
+    std::vector<State> expected_end_states;
+    for (const auto &s : solutions.nondominated_end_states) {
+      if (s.cost < cost_upper_bound) {
+        expected_end_states.push_back(s);
+      }
+    }
+    ASSERT_EQ(sorted(expected_end_states), sorted(bounded_solutions.nondominated_end_states));
+  }
+}
+
+TEST(rcsp, completion_bounds_prune_labels) {
+  for (int i = 1; i < 10; i++) {
+    const Instance instance(i % 4 + 5, 42 + i);
+    const auto &[s_t_g, generated_graph] = instance;
+    // Each delivery can also be made on the travel edges into its site, so that it is on several edges, and the
+    // deliveries have negative costs, as with the duals of column generation.
+    Graph graph = generated_graph;
+    for (const auto &v : generated_graph.get_vertices()) {
+      for (const auto &e : v.out_edges) {
+        const auto &target_out_edges = generated_graph.get_vertices()[e.vertex_index].out_edges;
+        const auto delivery = std::ranges::find_if(target_out_edges, [](const auto &target_out_edge) {
+          return target_out_edge.data.delivery_index < NOT_A_DELIVERY_MARKER;
+        });
+        if (e.vertex_index != v.index && delivery != target_out_edges.end()) {
+          auto data = e.data;
+          data.delivery_index = delivery->data.delivery_index;
+          graph.add_edge(v.index, e.vertex_index, data);
+        }
+      }
+    }
+    graph.update_cost_changes([](const ExtensionData &data) {
+      return data.delivery_index < NOT_A_DELIVERY_MARKER ? data.cost_change - 30 : data.cost_change;
+    });
+
+    PingPongWorkspace workspace;
+    auto solutions =
+      BasicSolutions(find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace));
+    const auto unpruned_stats = workspace.stats();
+    // Only the paths with a negative cost.
+    const auto &pruned_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace, {.cost_upper_bound = 0}
+    );
+    std::vector<State> expected_end_states;
+    std::ranges::copy_if(solutions.nondominated_end_states, std::back_inserter(expected_end_states), [](const auto &s) {
+      return s.cost < 0;
+    });
+    ASSERT_EQ(sorted(expected_end_states), sorted(pruned_solutions.nondominated_end_states));
+    ASSERT_LT(workspace.counters().labels_created, unpruned_stats.counters.labels_created);
+    if constexpr (search_stats) {
+      ASSERT_GT(workspace.stats().extensions.pruned, 0);
+      ASSERT_LT(workspace.stats().extensions.attempted, unpruned_stats.extensions.attempted);
+    }
+  }
+}
+
+TEST(rcsp, heuristic_options_give_feasible_paths) {
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+    auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    const int min_cost = std::ranges::min(solutions.nondominated_end_states, {}, &State::cost).cost;
+
+    // Limits that are never reached give the exact solutions.
+    auto unlimited_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{},
+      PingPongOptions{.max_labels_per_vertex = 1000000, .max_out_edges_per_vertex = 1000}
+    );
+    ASSERT_EQ(solutions.nondominated_end_states, unlimited_solutions.nondominated_end_states);
+    ASSERT_EQ(solutions.nondominated_paths, unlimited_solutions.nondominated_paths);
+
+    auto heuristic_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{},
+      PingPongOptions{.max_labels_per_vertex = 4, .max_out_edges_per_vertex = 3, .max_solutions = 1}
+    );
+    ASSERT_FALSE(heuristic_solutions.nondominated_end_states.empty());
+    // Replaying each path, with the out edge locations of graph, from the source gives its end state.
+    for (size_t j = 0; j < heuristic_solutions.nondominated_paths.size(); ++j) {
+      const auto &path = heuristic_solutions.nondominated_paths[j];
+      ASSERT_EQ(s_t_g.target_vertex, out_edge(graph, path.front()).vertex_index);
+      ASSERT_EQ(heuristic_solutions.nondominated_end_states[j], replay(graph, path));
+      ASSERT_GE(heuristic_solutions.nondominated_end_states[j].cost, min_cost);
+    }
+
+    // The lazy dominance keeps the cheapest of the nondominated labels too.
+    auto lazy_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{},
+      PingPongOptions{.lazy_dominance = true, .max_labels_per_vertex = 4}
+    );
+    auto eager_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, PingPongOptions{.max_labels_per_vertex = 4}
+    );
+    ASSERT_EQ(sorted(eager_solutions.nondominated_end_states), sorted(lazy_solutions.nondominated_end_states));
+  }
+}
+
+TEST(rcsp, reprice_gives_repriced_paths_of_last_search) {
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+    PingPongWorkspace workspace;
+    auto solutions = BasicSolutions(
+      find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace)
+    );
+
+    // With the same costs, the repriced label tree has the same Pareto set.
+    const auto &repriced_solutions = reprice_ping_pong_solutions(graph, workspace);
+    ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(repriced_solutions.nondominated_end_states));
+
+    std::vector<int> base_cost_changes;
+    for (Index edge_index = 0; edge_index < graph.edge_count(); ++edge_index) {
+      base_cost_changes.push_back(graph.get_extension_data(edge_index).cost_change);
+    }
+    std::vector<int> duals;
+    for (int delivery_index = 0; delivery_index < N_DELIVERIES; ++delivery_index) {
+      duals.push_back((delivery_index * 7 + seed) % 11);
+    }
+    graph.apply_duals(base_cost_changes, duals);
+    const auto &dual_solutions = reprice_ping_pong_solutions(graph, workspace);
+    ASSERT_FALSE(dual_solutions.nondominated_end_states.empty());
+    for (size_t j = 0; j < dual_solutions.nondominated_paths.size(); ++j) {
+      ASSERT_EQ(dual_solutions.nondominated_end_states[j], replay(graph, dual_solutions.nondominated_paths[j]));
+    }
+  }
+}
+
+TEST(rcsp, visit_gives_solutions_in_cost_order) {
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    generate(i % 6 + 1, 42 + i, s_t_g);
+    const CsrGraph graph(convert_to_graph(s_t_g.graph));
+    const auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+
+    PingPongWorkspace workspace;
+    std::vector<std::pair<std::vector<EdgeLocation>, State>> visited;
+    visit_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace,
+      [&visited](std::span<const EdgeLocation> path, const State &end_state) {
+        visited.emplace_back(std::vector(path.begin(), path.end()), end_state);
+        return true;
+      }
+    );
+    ASSERT_EQ(solutions.nondominated_paths.size(), visited.size());
+    ASSERT_TRUE(std::ranges::is_sorted(visited, {}, [](const auto &v) { return v.second.cost; }));
+    for (const auto &[path, end_state] : visited) {
+      const auto it = std::ranges::find(solutions.nondominated_end_states, end_state);
+      ASSERT_NE(it, solutions.nondominated_end_states.end());
+      const auto &expected_path = solutions.nondominated_paths[it - solutions.nondominated_end_states.begin()];
+      ASSERT_TRUE(std::ranges::equal(expected_path, path));
+    }
+
+    // Stopping after the first visit gives the cheapest solution.
+    size_t visit_count = 0;
+    visit_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace,
+      [&](std::span<const EdgeLocation>, const State &end_state) {
+        ++visit_count;
+        EXPECT_EQ(visited.front().second.cost, end_state.cost);
+        return false;
+      }
+    );
+    ASSERT_EQ(std::min<size_t>(1, visited.size()), visit_count);
+
+    // A const visitor
+    size_t const_visit_count = 0;
+    auto count_visits = [&const_visit_count](std::span<const EdgeLocation>, const State &) {
+      ++const_visit_count;
+      return true;
+    };
+    visit_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace, std::as_const(count_visits)
+    );
+    ASSERT_EQ(visited.size(), const_visit_count);
+  }
+}
+
+TEST(rcsp, time_windows_give_identical_solutions) {
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 6 + 1;
+    generate(sites_count, seed, s_t_g);
+    // Deliveries that can not start before some time, so that the labels wait.
+    for (const auto &e : boost::make_iterator_range(boost::edges(s_t_g.graph))) {
+      auto &data = s_t_g.graph[e];
+      if (data.delivery_index < NOT_A_DELIVERY_MARKER) {
+        data.earliest_time = (data.delivery_index * 13 + seed) % 50;
+      }
+    }
+    auto boost_solutions = find_boost_solutions(s_t_g, State{});
+    auto graph = convert_to_graph(s_t_g.graph);
+    const auto expected_end_states = sorted(boost_solutions.nondominated_end_states);
+
+    auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    ASSERT_EQ(expected_end_states, sorted(solutions.nondominated_end_states));
+    auto bucketed_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, PingPongOptions{.time_bucket_width = 5}
+    );
+    ASSERT_EQ(expected_end_states, sorted(bucketed_solutions.nondominated_end_states));
+    auto pruned_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, PingPongOptions{.prune_with_completion_bounds = true}
+    );
+    ASSERT_EQ(expected_end_states, sorted(pruned_solutions.nondominated_end_states));
+    auto time_queue_solutions = find_ping_pong_solutions(
+      graph, s_t_g.source_vertex, s_t_g.target_vertex, State{},
+      PingPongOptions{.schedule = PingPongSchedule::time_queue}
+    );
+    ASSERT_EQ(expected_end_states, sorted(time_queue_solutions.nondominated_end_states));
+    auto bidirectional_solutions =
+      find_bidirectional_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{});
+    ASSERT_EQ(expected_end_states.size(), bidirectional_solutions.nondominated_end_states.size());
+    for (size_t j = 0; j < bidirectional_solutions.nondominated_paths.size(); ++j) {
+      const auto &path = bidirectional_solutions.nondominated_paths[j];
+      ASSERT_EQ(bidirectional_solutions.nondominated_end_states[j], replay(graph, path));
+    }
+  }
+}
+
+TEST(rcsp, time_queue_gives_identical_solutions) {
+  for (int i = 1; i < 30; i++) {
+    const Instance instance(i % 7 + 1, 42 + i);
+    const auto &[s_t_g, graph] = instance;
+    auto solutions = instance.solve();
+    PingPongWorkspace workspace;
+    for (int repetition = 0; repetition < 2; ++repetition) {
+      // also with a reused workspace
+      const auto &time_queue_solutions = find_ping_pong_solutions(
+        graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace,
+        PingPongOptions{.schedule = PingPongSchedule::time_queue, .prune_with_completion_bounds = repetition == 1}
+      );
+      ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(time_queue_solutions.nondominated_end_states));
+    }
+  }
+}
+
+TEST(rcsp, lazy_dominance_gives_identical_solutions) {
+  ThreadPool pool(3);
+  for (int i = 1; i < 30; i++) {
+    const Instance instance(i % 7 + 1, 42 + i);
+    auto solutions = instance.solve();
+    auto lazy_solutions = instance.solve({.lazy_dominance = true});
+    ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(lazy_solutions.nondominated_end_states));
+    auto parallel_lazy_solutions = instance.solve({.thread_pool = &pool, .lazy_dominance = true});
+    ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(parallel_lazy_solutions.nondominated_end_states));
+  }
+}
+
+TEST(rcsp, vertex_orders_give_identical_solutions) {
+  ThreadPool pool(3);
+  for (const auto family : {InstanceFamily::uniform, InstanceFamily::tight_windows}) {
+    for (int i = 1; i < 20; i++) {
+      const Instance instance(i % 7 + 1, 42 + i, family);
+      auto solutions = instance.solve();
+      for (const auto order : {VertexOrder::min_cost, VertexOrder::min_average_cost_change,
+                               VertexOrder::topological_by_time}) {
+        for (ThreadPool *thread_pool : {static_cast<ThreadPool *>(nullptr), &pool}) {
+          auto ordered_solutions = instance.solve({.vertex_order = order, .thread_pool = thread_pool});
+          ASSERT_EQ(sorted(solutions.nondominated_end_states), sorted(ordered_solutions.nondominated_end_states));
+        }
+      }
+    }
+  }
+}
+
+TEST(rcsp, vertex_orders_reorder_the_vertices) {
+  const Instance instance(8, 43);
+  const auto vertex_count = instance.graph.get_vertices().size();
+  for (const auto order : {VertexOrder::min_average_cost_change, VertexOrder::topological_by_time}) {
+    PingPongWorkspace workspace;
+    find_ping_pong_solutions(
+      instance.graph, instance.s_t_g.source_vertex, instance.s_t_g.target_vertex, State{}, workspace,
+      {.vertex_order = order}
+    );
+    // a permutation of the vertices that is not the order of their indices
+    const auto vertex_order = workspace.vertex_order();
+    ASSERT_EQ(vertex_count, vertex_order.size());
+    ASSERT_TRUE(std::ranges::is_permutation(vertex_order, views::iota(size_t{0}, vertex_count)));
+    ASSERT_FALSE(std::ranges::is_sorted(vertex_order));
+  }
+}
+
+TEST(rcsp, label_tree_compaction_gives_identical_paths) {
+  ThreadPool pool(3);
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    int seed = 42 + i;
+    int sites_count = i % 7 + 1;
+    generate(sites_count, seed, s_t_g);
+    auto graph = convert_to_graph(s_t_g.graph);
+
+    for (const PingPongOptions &options :
+         {PingPongOptions{}, PingPongOptions{.schedule = PingPongSchedule::time_queue},
+          PingPongOptions{.thread_pool = &pool}, PingPongOptions{.max_out_edges_per_vertex = 3}}) {
+      auto solutions = find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, options);
+      // compact from the first round on
+      PingPongOptions compacting_options = options;
+      compacting_options.label_tree_compaction_size = 1;
+      auto compacted_solutions =
+        find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, compacting_options);
+      ASSERT_EQ(solutions.nondominated_paths, compacted_solutions.nondominated_paths);
+      ASSERT_EQ(solutions.nondominated_end_states, compacted_solutions.nondominated_end_states);
+    }
+  }
+}
+
+TEST(rcsp, counters_add_up) {
+  ThreadPool pool(3);
+  for (int i = 1; i < 30; i++) {
+    SourceTargetBoostGraph s_t_g;
+    generate(i % 7 + 1, 42 + i, s_t_g);
+    const CsrGraph graph(convert_to_graph(s_t_g.graph));
+
+    PingPongWorkspace workspace;
+    const auto &solutions =
+      find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace);
+    const auto counters = workspace.counters();
+    ASSERT_GT(counters.rounds, 0);
+    ASSERT_EQ(counters.labels_created + 1, counters.peak_label_tree_size);
+    // The solutions and the labels that were extended are the labels that were not dominated.
+    ASSERT_GE(counters.labels_created - counters.labels_dominated, solutions.nondominated_end_states.size());
+    ASSERT_EQ(counters.rounds, solutions.stats.counters.rounds);
+    const auto &extensions = solutions.stats.extensions;
+    if constexpr (search_stats) {
+      // Each extension is rejected once or creates a label.
+      ASSERT_EQ(
+        extensions.attempted, extensions.infeasible + extensions.pruned + extensions.dominated + counters.labels_created
+      );
+      ASSERT_GE(extensions.dominance_checks, extensions.dominated);
+      ASSERT_GT(workspace.stats().peak_labels_per_vertex, 0);
+    } else {
+      ASSERT_EQ(0, extensions.attempted);
+    }
+
+    for (const PingPongOptions &options :
+         {PingPongOptions{.thread_pool = &pool}, PingPongOptions{.lazy_dominance = true},
+          PingPongOptions{.label_tree_compaction_size = 1}}) {
+      find_ping_pong_solutions(graph, s_t_g.source_vertex, s_t_g.target_vertex, State{}, workspace, options);
+      ASSERT_EQ(counters.rounds, workspace.counters().rounds);
+      // The parallel rounds also extend the labels that become dominated during a round, see extend_round_parallel,
+      // and the lazy dominance checks fewer labels, so only the compaction creates the same labels.
+      if (options.label_tree_compaction_size) {
+        ASSERT_EQ(counters.labels_created, workspace.counters().labels_created);
+        ASSERT_EQ(counters.labels_dominated, workspace.counters().labels_dominated);
+      }
+    }
+  }
+}
+
+TEST(rcsp, phase_times_add_up_to_at_most_the_search_time) {
+  if constexpr (!search_stats) {
+    GTEST_SKIP() << "the phases are only timed with search_stats";
+  }
+  const Instance instance(8, 43);
+  for (const auto schedule : {PingPongSchedule::rounds, PingPongSchedule::time_queue}) {
+    PingPongWorkspace workspace;
+    const auto start = std::chrono::steady_clock::now();
+    find_ping_pong_solutions(
+      instance.graph, instance.s_t_g.source_vertex, instance.s_t_g.target_vertex, State{}, workspace,
+      {.schedule = schedule, .label_tree_compaction_size = 1}
+    );
+    const auto search_time = std::chrono::steady_clock::now() - start;
+    // The phases do not overlap, e.g. the label tree compactions of the time queue are not part of the extension time.
+    const auto &stats = workspace.stats();
+    ASSERT_GT(stats.compaction_time.count(), 0);
+    ASSERT_LE(
+      stats.compaction_time + stats.vertex_ordering_time + stats.extension_time + stats.path_reconstruction_time,
+      search_time
+    );
+  }
+}
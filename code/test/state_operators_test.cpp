@@ -52,3 +52,27 @@ TEST(state, greater_than) {
   s1.time = 5;
   ASSERT_GT(s1, s2);
 }
+
+TEST(delivery_set, subset) {
+  DeliverySet lhs;
+  DeliverySet rhs;
+  ASSERT_TRUE(lhs.is_subset_of(rhs));
+  lhs.set(3);
+  ASSERT_FALSE(lhs.is_subset_of(rhs));
+  rhs.set(3).set(31);
+  ASSERT_TRUE(lhs.is_subset_of(rhs));
+  ASSERT_FALSE(rhs.is_subset_of(lhs));
+}
+
+TEST(delivery_set, multi_word_subset) {
+  BasicDeliverySet<256> lhs;
+  BasicDeliverySet<256> rhs;
+  lhs.set(0).set(64).set(255);
+  rhs.set(0).set(64);
+  ASSERT_FALSE(lhs.is_subset_of(rhs));
+  ASSERT_TRUE(rhs.is_subset_of(lhs));
+  rhs.set(255).set(128);
+  ASSERT_TRUE(lhs.is_subset_of(rhs));
+  ASSERT_TRUE(rhs.test(128));
+  ASSERT_FALSE(lhs.test(128));
+}
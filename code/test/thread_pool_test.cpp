@@ -0,0 +1,36 @@
+// Performance experiments for Resource Constrained Shortest Path Problem.
+// Copyright (C) 2025 Douglas Wayne Potter
+//
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General
+// Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more
+// details.
+//
+// You should have received a copy of the GNU Affero General Public License along with this program. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+
+#include "../../code/src/thread_pool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace perf_rcsp;
+
+TEST(thread_pool, runs_every_task_once) {
+  ThreadPool pool(4);
+  for (size_t task_count : {0, 1, 3, 4, 5, 100}) {
+    std::vector<std::atomic<int>> runs(task_count);
+    pool.parallel_for(task_count, [&](size_t task_index, size_t thread_index) {
+      ASSERT_LT(thread_index, pool.size());
+      ++runs[task_index];
+    });
+    for (const auto &r : runs) {
+      ASSERT_EQ(1, r);
+    }
+  }
+}